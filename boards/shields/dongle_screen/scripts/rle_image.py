@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Write images as run-length encoded LVGL image descriptors for src/rle_image.c.
+
+Layout of the image data:
+  - one little endian uint32 per row, the offset of the row from the start of the data
+  - the rows, each a sequence of packets: a tag byte, with bit 7 set a run of
+    (tag & 0x7f) + 1 copies of the following pixel, otherwise (tag + 1) literal pixels
+Pixels are RGB565 in LVGL byte order (2 bytes), followed by an alpha byte for images with alpha.
+Rows can be decoded on their own, so the decoder never needs more than the requested line.
+
+Used as a module by subset_lv_font.py, or on its own to convert a PNG (needs Pillow):
+  rle_image.py --name splash --output splash.c [--alpha] [--swap] splash.png
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAX_PACKET = 128
+
+
+def encode_row(pixels):
+    """Encode one row, pixels is a list of bytes objects of equal size."""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_PACKET]
+            del literal[:MAX_PACKET]
+            out.append(len(chunk) - 1)
+            for pixel in chunk:
+                out.extend(pixel)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < MAX_PACKET and pixels[i + run] == pixels[i]:
+            run += 1
+
+        # A run of two already costs less than two literal pixels
+        if run >= 2:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.extend(pixels[i])
+            i += run
+        else:
+            literal.append(pixels[i])
+            i += 1
+
+    flush_literal()
+    return bytes(out)
+
+
+def encode(rows):
+    """Encode an image given as a list of rows, returns the image data with the row offset table."""
+    encoded = [encode_row(row) for row in rows]
+    offset = 4 * len(rows)
+    table = bytearray()
+    for row in encoded:
+        table.extend(struct.pack("<I", offset))
+        offset += len(row)
+    return bytes(table) + b"".join(encoded)
+
+
+def rgb565(r, g, b, swap):
+    value = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+    return bytes([value >> 8, value & 0xFF]) if swap else bytes([value & 0xFF, value >> 8])
+
+
+def c_image(name, width, height, data, cf, comment=None):
+    """C source of an lv_img_dsc_t holding the image data."""
+    out = []
+    if comment:
+        out.append("/* {} */".format(comment))
+    out.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t {}_map[] = {{".format(name))
+    for i in range(0, len(data), 16):
+        out.append("    " + ", ".join("0x{:02x}".format(b) for b in data[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("const lv_img_dsc_t {} = {{".format(name))
+    out.append("    .header.cf = {},".format(cf))
+    out.append("    .header.always_zero = 0,")
+    out.append("    .header.reserved = 0,")
+    out.append("    .header.w = {},".format(width))
+    out.append("    .header.h = {},".format(height))
+    out.append("    .data_size = {},".format(len(data)))
+    out.append("    .data = {}_map,".format(name))
+    out.append("};")
+    out.append("")
+    return out
+
+
+def c_prologue(source, swap, rle=True, generator="rle_image.py"):
+    return [
+        "/*",
+        " * Images generated from {} by {}, do not edit".format(source, generator),
+        " */",
+        "",
+        "#include \"lvgl.h\"",
+    ] + (["#include \"rle_image.h\""] if rle else []) + [
+        "",
+        "#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP != {}".format(1 if swap else 0),
+        "#error \"The images were generated for a different color format\"",
+        "#endif",
+        "",
+    ]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--name", required=True, help="name of the lv_img_dsc_t")
+    parser.add_argument("--output", required=True, help="C file to write")
+    parser.add_argument("--alpha", action="store_true", help="keep the alpha channel")
+    parser.add_argument("--swap", action="store_true", help="write pixels for LV_COLOR_16_SWAP")
+    parser.add_argument("input", help="PNG file")
+    args = parser.parse_args()
+
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("rle_image: converting PNG files needs Pillow (pip install Pillow)")
+
+    image = Image.open(args.input).convert("RGBA")
+    width, height = image.size
+    pixels = image.load()
+
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            r, g, b, a = pixels[x, y]
+            pixel = rgb565(r, g, b, args.swap)
+            row.append(pixel + bytes([a]) if args.alpha else pixel)
+        rows.append(row)
+
+    data = encode(rows)
+    raw_size = width * height * (3 if args.alpha else 2)
+    print("rle_image: {} {}x{}, {} -> {} bytes".format(args.name, width, height, raw_size, len(data)))
+
+    out = c_prologue(os.path.basename(args.input), args.swap)
+    cf = "RLE_IMAGE_CF_ALPHA" if args.alpha else "RLE_IMAGE_CF_OPAQUE"
+    out.extend(c_image(args.name, width, height, data, cf))
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Write a copy of an lv_font_conv font C file that only contains the given glyphs.
+
+The checked in fonts stay the masters, the build compiles the subset generated from them.
+Only uncompressed fonts without kerning are supported, which is what lv_font_conv writes
+with --no-compress for the monospace NerdFont.
+
+The subset can be requantized to fewer bits per pixel (--bpp), and glyphs can also be written
+as RGB565 images pre-blended onto a solid background (--sprites-output), which LVGL copies
+into the draw buffer without any per pixel blending, optionally run-length encoded (--rle).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+import rle_image
+
+GLYPH_COMMENT = re.compile(r"/\* U\+([0-9A-Fa-f]+) .*\*/")
+GLYPH_DSC = re.compile(r"\{\.bitmap_index = (\d+), (\.adv_w = .*?)\}")
+
+
+def section(text, start, end):
+    begin = text.index(start)
+    return begin, text.index(end, begin) + len(end)
+
+
+def parse_font(text):
+    """Return the glyphs as {codepoint: (bitmap bytes, dsc fields)} plus the surrounding text."""
+    if not re.search(r"\.bitmap_format = 0\b", text):
+        sys.exit("subset_lv_font: compressed fonts are not supported")
+    if not re.search(r"\.kern_dsc = NULL\b", text):
+        sys.exit("subset_lv_font: fonts with kerning are not supported")
+
+    bitmap_start, bitmap_end = section(text, "glyph_bitmap[] = {", "};")
+    codepoints = []
+    bitmaps = []
+    for line in text[bitmap_start:bitmap_end].splitlines()[1:-1]:
+        match = GLYPH_COMMENT.search(line)
+        if match:
+            codepoints.append(int(match.group(1), 16))
+            bitmaps.append([])
+        elif bitmaps:
+            bitmaps[-1].extend(b.strip() for b in line.split(",") if b.strip())
+
+    dsc_start, dsc_end = section(text, "glyph_dsc[] = {", "};")
+    # Skip the reserved id 0
+    dscs = GLYPH_DSC.findall(text[dsc_start:dsc_end])[1:]
+
+    if len(dscs) != len(codepoints):
+        sys.exit("subset_lv_font: found {} glyph descriptors for {} bitmaps".format(
+            len(dscs), len(codepoints)))
+
+    glyphs = {cp: (bitmap, dsc[1]) for cp, bitmap, dsc in zip(codepoints, bitmaps, dscs)}
+    return glyphs, bitmap_start, dsc_end
+
+
+def font_param(text, name):
+    return int(re.search(r"\.{} = (-?\d+)".format(name), text).group(1))
+
+
+def glyph_param(dsc, name):
+    return int(re.search(r"\.{} = (-?\d+)".format(name), dsc).group(1))
+
+
+def unpack(data, bpp, count):
+    """Pixel values of a glyph bitmap, packed MSB first without row padding."""
+    raw = bytes(int(b, 0) for b in data)
+    mask = (1 << bpp) - 1
+    return [(raw[(i * bpp) >> 3] >> (8 - bpp - ((i * bpp) & 7))) & mask for i in range(count)]
+
+
+def pack(values, bpp):
+    out = bytearray((len(values) * bpp + 7) // 8)
+    for i, value in enumerate(values):
+        out[(i * bpp) >> 3] |= value << (8 - bpp - ((i * bpp) & 7))
+    return ["0x{:x}".format(b) for b in out]
+
+
+def requantize(glyphs, src_bpp, bpp):
+    """Reduce every glyph bitmap to bpp bits per pixel, rounding to the nearest level."""
+    src_max = (1 << src_bpp) - 1
+    dst_max = (1 << bpp) - 1
+    result = {}
+    for cp, (data, dsc) in glyphs.items():
+        count = glyph_param(dsc, "box_w") * glyph_param(dsc, "box_h")
+        values = [(v * dst_max * 2 + src_max) // (src_max * 2) for v in unpack(data, src_bpp, count)]
+        result[cp] = (pack(values, bpp), dsc)
+    return result
+
+
+def cmap_ranges(codepoints):
+    """Group consecutive codepoints, each group becomes one FORMAT0_TINY cmap."""
+    ranges = []
+    for cp in codepoints:
+        if ranges and ranges[-1][0] + ranges[-1][1] == cp:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([cp, 1])
+    return ranges
+
+
+def write_subset(text, glyphs, bitmap_start, dsc_end, codepoints, source, bpp):
+    # Everything up to the bitmap array name is kept, with a note about the subset in the header
+    prefix = text[:bitmap_start].replace(
+        " ******************************************************************************/",
+        " * Subset: {}\n * Generated from {} by subset_lv_font.py, do not edit\n"
+        " ******************************************************************************/".format(
+            " ".join("U+{:04X}".format(cp) for cp in codepoints), source),
+        1,
+    )
+    src_bpp = font_param(text, "bpp")
+    if bpp != src_bpp:
+        prefix = prefix.replace(" * Bpp: {}".format(src_bpp), " * Bpp: {} (requantized from {})".format(
+            bpp, src_bpp), 1)
+
+    out = [prefix + "glyph_bitmap[] = {"]
+    for cp in codepoints:
+        out.append("    /* U+{:04X} */".format(cp))
+        data = glyphs[cp][0]
+        for i in range(0, len(data), 8):
+            out.append("    " + ", ".join(data[i:i + 8]) + ",")
+        out.append("")
+    out.append("};")
+    out.append("")
+    out.append("static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {")
+    out.append("    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0}"
+               " /* id = 0 reserved */,")
+    index = 0
+    for cp in codepoints:
+        out.append("    {{.bitmap_index = {}, {}}},".format(index, glyphs[cp][1]))
+        index += len(glyphs[cp][0])
+    out.append("};")
+    out.append("")
+
+    out.append("/*---------------------")
+    out.append(" *  CHARACTER MAPPING")
+    out.append(" *--------------------*/")
+    out.append("")
+    ranges = cmap_ranges(codepoints)
+    out.append("static const lv_font_fmt_txt_cmap_t cmaps[] =")
+    out.append("{")
+    glyph_id = 1
+    for start, length in ranges:
+        out.append("    {")
+        out.append("        .range_start = {}, .range_length = {}, .glyph_id_start = {},".format(
+            start, length, glyph_id))
+        out.append("        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, "
+                   ".type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY")
+        out.append("    },")
+        glyph_id += length
+    out.append("};")
+    out.append("")
+
+    # Everything from the custom data on is kept, only the number of cmaps and the bpp change
+    tail = text[text.index("/*--------------------\n *  ALL CUSTOM DATA", dsc_end):]
+    tail = re.sub(r"\.cmap_num = \d+", ".cmap_num = {}".format(len(ranges)), tail, count=1)
+    tail = re.sub(r"\.bpp = \d+", ".bpp = {}".format(bpp), tail, count=1)
+    out.append(tail)
+
+    return "\n".join(out)
+
+
+def parse_color(value):
+    color = int(value, 16)
+    return (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF
+
+
+def write_sprites(text, glyphs, sprites, fg, bg, swap, rle, source):
+    """Write every glyph as a full character cell RGB565 image, placed like LVGL draws the letter."""
+    bpp = font_param(text, "bpp")
+    line_height = font_param(text, "line_height")
+    base_line = font_param(text, "base_line")
+    level_max = (1 << bpp) - 1
+
+    out = rle_image.c_prologue(source, swap, rle, "subset_lv_font.py")
+
+    for name, cp in sprites:
+        data, dsc = glyphs[cp]
+        box_w = glyph_param(dsc, "box_w")
+        box_h = glyph_param(dsc, "box_h")
+        ofs_x = glyph_param(dsc, "ofs_x")
+        ofs_y = glyph_param(dsc, "ofs_y")
+        width = (glyph_param(dsc, "adv_w") + 15) // 16
+        values = unpack(data, bpp, box_w * box_h)
+
+        top = line_height - base_line - box_h - ofs_y
+        rows = []
+        for y in range(line_height):
+            row = []
+            for x in range(width):
+                gx = x - ofs_x
+                gy = y - top
+                level = values[gy * box_w + gx] if 0 <= gx < box_w and 0 <= gy < box_h else 0
+                r, g, b = (
+                    (f * level + k * (level_max - level) + level_max // 2) // level_max for f, k in zip(fg, bg)
+                )
+                row.append(rle_image.rgb565(r, g, b, swap))
+            rows.append(row)
+
+        comment = "U+{:04X}".format(cp)
+        if rle:
+            out.extend(rle_image.c_image(name, width, line_height, rle_image.encode(rows),
+                                         "RLE_IMAGE_CF_OPAQUE", comment))
+        else:
+            pixels = b"".join(b"".join(row) for row in rows)
+            out.extend(rle_image.c_image(name, width, line_height, pixels, "LV_IMG_CF_TRUE_COLOR",
+                                         comment))
+
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--input", required=True, help="lv_font_conv C file")
+    parser.add_argument("--output", help="subset C file to write")
+    parser.add_argument("--glyphs", nargs="+", default=[], help="codepoints, e.g. 0xF0634")
+    parser.add_argument("--bpp", type=int, choices=[1, 2, 4], help="bits per pixel of the subset")
+    parser.add_argument("--sprites-output", help="C file to write the pre-blended glyph images to")
+    parser.add_argument("--sprite", nargs="+", default=[], help="images to write, e.g. mod_icon_ctrl=0xF0634")
+    parser.add_argument("--sprite-color", default="ffffff", help="glyph color of the images")
+    parser.add_argument("--sprite-background", default="000000", help="background color of the images")
+    parser.add_argument("--swap", action="store_true", help="write images for LV_COLOR_16_SWAP")
+    parser.add_argument("--rle", action="store_true", help="run-length encode the images (src/rle_image.c)")
+    args = parser.parse_args()
+
+    with open(args.input, encoding="utf-8") as f:
+        text = f.read()
+
+    glyphs, bitmap_start, dsc_end = parse_font(text)
+    codepoints = sorted({int(g, 0) for g in args.glyphs})
+
+    missing = [cp for cp in codepoints if cp not in glyphs]
+    if missing:
+        sys.exit("subset_lv_font: {} has no glyph for {}".format(
+            args.input, " ".join("U+{:04X}".format(cp) for cp in missing)))
+
+    source = os.path.basename(args.input)
+
+    if args.sprites_output:
+        sprites = [(name, int(cp, 0)) for name, cp in (s.split("=") for s in args.sprite)]
+        missing = [cp for _, cp in sprites if cp not in glyphs]
+        if missing:
+            sys.exit("subset_lv_font: {} has no glyph for {}".format(
+                args.input, " ".join("U+{:04X}".format(cp) for cp in missing)))
+        with open(args.sprites_output, "w", encoding="utf-8") as f:
+            f.write(write_sprites(text, glyphs, sprites, parse_color(args.sprite_color),
+                                  parse_color(args.sprite_background), args.swap, args.rle, source))
+
+    if not args.output:
+        return
+
+    subset = {cp: glyphs[cp] for cp in codepoints}
+    src_bpp = font_param(text, "bpp")
+    bpp = args.bpp or src_bpp
+    if bpp != src_bpp:
+        subset = requantize(subset, src_bpp, bpp)
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(write_subset(text, subset, bitmap_start, dsc_end, codepoints, source, bpp))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include "battery_trend.h"
+#include "widgets/battery_status.h"
+
+#define TREND_SAMPLES CONFIG_DONGLE_SCREEN_BATTERY_TREND_SAMPLES
+
+// Least squares fit of level over time, kept as running sums over the samples in the ring.
+// Timestamps are seconds relative to the first sample after a reset, so the 64 bit sums
+// stay far from overflowing for uptimes of several months.
+struct battery_trend
+{
+    int64_t base_ms;
+    int64_t newest_ms;
+    uint32_t t[TREND_SAMPLES];
+    uint8_t level[TREND_SAMPLES];
+    uint8_t head;
+    uint8_t count;
+    int64_t sum_t;
+    int64_t sum_l;
+    int64_t sum_tt;
+    int64_t sum_tl;
+};
+
+static struct battery_trend trends[BATTERY_SOURCE_COUNT];
+
+void battery_trend_reset(uint8_t source)
+{
+    if (source >= BATTERY_SOURCE_COUNT)
+    {
+        return;
+    }
+    memset(&trends[source], 0, sizeof(trends[source]));
+}
+
+void battery_trend_add_sample(uint8_t source, uint8_t level, int64_t timestamp_ms)
+{
+    if (source >= BATTERY_SOURCE_COUNT)
+    {
+        return;
+    }
+
+    struct battery_trend *trend = &trends[source];
+
+    if (trend->count == 0)
+    {
+        trend->base_ms = timestamp_ms;
+    }
+
+    if (trend->count == TREND_SAMPLES)
+    {
+        // Ring is full, the slot at head holds the oldest sample which is evicted
+        int64_t old_t = trend->t[trend->head];
+        int64_t old_l = trend->level[trend->head];
+
+        trend->sum_t -= old_t;
+        trend->sum_l -= old_l;
+        trend->sum_tt -= old_t * old_t;
+        trend->sum_tl -= old_t * old_l;
+    }
+    else
+    {
+        trend->count++;
+    }
+
+    int64_t t = (timestamp_ms - trend->base_ms) / 1000;
+
+    trend->newest_ms = timestamp_ms;
+
+    trend->t[trend->head] = t;
+    trend->level[trend->head] = level;
+    trend->head = (trend->head + 1) % TREND_SAMPLES;
+
+    trend->sum_t += t;
+    trend->sum_l += level;
+    trend->sum_tt += t * t;
+    trend->sum_tl += t * level;
+}
+
+// Slope of the fit as num / denom in percent per second. Returns false if it is undefined.
+static bool battery_trend_slope(const struct battery_trend *trend, int64_t *num, int64_t *denom)
+{
+    if (trend->count < 2)
+    {
+        return false;
+    }
+
+    *num = trend->count * trend->sum_tl - trend->sum_t * trend->sum_l;
+    *denom = trend->count * trend->sum_tt - trend->sum_t * trend->sum_t;
+
+    return *denom > 0;
+}
+
+int32_t battery_trend_discharge_rate(uint8_t source)
+{
+    int64_t num, denom;
+
+    if (source >= BATTERY_SOURCE_COUNT || !battery_trend_slope(&trends[source], &num, &denom))
+    {
+        return 0;
+    }
+
+    // %/s -> 1/100 %/h
+    return (int32_t)(-num * 3600 * 100 / denom);
+}
+
+int32_t battery_trend_time_to_empty_s(uint8_t source)
+{
+    int64_t num, denom;
+
+    if (source >= BATTERY_SOURCE_COUNT || !battery_trend_slope(&trends[source], &num, &denom) || num >= 0)
+    {
+        return -1;
+    }
+
+    const struct battery_trend *trend = &trends[source];
+    uint8_t newest = (trend->head + TREND_SAMPLES - 1) % TREND_SAMPLES;
+    int64_t tte = (int64_t)trend->level[newest] * denom / -num;
+
+    // Counts down between samples, levels are only reported when they change
+    tte -= (k_uptime_get() - trend->newest_ms) / 1000;
+
+    return (int32_t)CLAMP(tte, 0, INT32_MAX);
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+static int cmd_battery(const struct shell *sh, size_t argc, char **argv)
+{
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++)
+    {
+        int32_t rate = battery_trend_discharge_rate(i);
+        int32_t tte = battery_trend_time_to_empty_s(i);
+        // Signed separately, the integer part of rates between -1 and 0 is 0
+        const char *sign = rate < 0 ? "-" : "";
+
+        if (tte < 0)
+        {
+            shell_print(sh, "source %d: %d samples, rate %s%d.%02d %%/h, time to empty unknown", i,
+                        trends[i].count, sign, abs(rate) / 100, abs(rate) % 100);
+        }
+        else
+        {
+            shell_print(sh, "source %d: %d samples, rate %s%d.%02d %%/h, time to empty %dh %02dm", i,
+                        trends[i].count, sign, abs(rate) / 100, abs(rate) % 100, tte / 3600, (tte % 3600) / 60);
+        }
+    }
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((dongle_screen), battery, NULL, "Show battery discharge rate and time to empty", cmd_battery, 1, 0);
+
+#endif
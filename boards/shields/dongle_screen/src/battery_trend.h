@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Record a battery level sample for a source
+ * Samples are kept in a fixed ring per source and the regression sums are
+ * updated incrementally, so this is O(1).
+ */
+void battery_trend_add_sample(uint8_t source, uint8_t level, int64_t timestamp_ms);
+
+/**
+ * @brief Forget all samples of a source, e.g. after it disconnected
+ */
+void battery_trend_reset(uint8_t source);
+
+/**
+ * @brief Discharge rate in hundredths of a percent per hour
+ * Positive while discharging, 0 if not enough samples are available.
+ */
+int32_t battery_trend_discharge_rate(uint8_t source);
+
+/**
+ * @brief Estimated time from now until the battery of a source is empty in seconds
+ * Counts down from the newest sample and stops at 0. Returns a negative value if the source
+ * is not discharging or there are not enough samples.
+ */
+int32_t battery_trend_time_to_empty_s(uint8_t source);
@@ -6,9 +6,14 @@
 #include <zmk/event_manager.h>
 #include <zmk/events/keycode_state_changed.h>
 #include <zmk/events/layer_state_changed.h>
-#include <math.h>
+#if IS_ENABLED(CONFIG_BT)
+#include <zephyr/bluetooth/conn.h>
+#endif
 #include <stdlib.h>
 
+#include "brightness.h"
+#include "brightness_fade.h"
+
 int random0to100()
 {
     return rand() % 101; // 0 to 100
@@ -89,7 +94,7 @@ static uint8_t clamp_brightness(int8_t value)
 static void apply_brightness(uint8_t value)
 {
     led_set_brightness(pwm_leds_dev, DISP_BL, value);
-    LOG_INF("Screen brightness set to %d", value);
+    LOG_DBG("Screen brightness set to %d", value); // Called for every step of a fade
 }
 
 static int8_t calculate_safe_modifier_change(uint8_t base_brightness, int8_t current_modifier, int8_t desired_change)
@@ -213,17 +218,6 @@ struct fade_request_t
 // It holds up to 4 fade_request_t elements and ensures brightness updates are handled sequentially.
 K_MSGQ_DEFINE(fade_msgq, sizeof(struct fade_request_t), FADE_QUEUE_SIZE, 4);
 
-// Cubic ease-in-out function to smooth the interpolation curve.
-// Provides a natural "S-curve" animation effect: starts slow, accelerates, then slows again.
-// Helps avoid abrupt changes in perceived brightness.
-static float ease_in_out(float t)
-{
-    if (t < 0.5f)
-        return 4.0f * t * t * t;
-    float f = -2.0f * t + 2.0f;
-    return 1.0f - (f * f * f) / 2.0f;
-}
-
 // Dedicated thread responsible for handling all fade animations.
 // Receives fade requests from the queue and applies brightness changes over time using easing.
 void fade_thread(void)
@@ -235,31 +229,26 @@ void fade_thread(void)
         // Wait indefinitely for the next fade request to arrive in the queue
         if (k_msgq_get(&fade_msgq, &req, K_FOREVER) == 0)
         {
+            req.from = MIN(req.from, 100);
+            req.to = MIN(req.to, 100);
 
             // Skip animation entirely if brightness difference is too small
             if (req.from == req.to || abs(req.to - req.from) <= 1)
             {
                 apply_brightness(req.to);
+                LOG_INF("Screen brightness set to %d", req.to);
                 continue;
             }
 
-            // Calculate brightness difference and use it to determine number of steps
-            int diff = abs(req.to - req.from);
-            int steps = CLAMP(diff * 2, 6, 32); // More steps for smoother fades over large differences
-
-            // Set total animation time: scale with difference but clamp between 500ms and 1000ms
-            int total_duration_ms = CLAMP(diff * 20, 500, 1000); // 20ms per level as baseline
-            int delay_us = (total_duration_ms * 1000) / steps;   // Delay between steps in microseconds
-
+            struct brightness_fade fade;
+            brightness_fade_plan(&fade, req.from, req.to);
             uint8_t last_applied = 255; // Used to prevent redundant LED updates to save performance
 
-            // Interpolate brightness across 'steps' frames using easing
-            for (int i = 0; i <= steps; i++)
+            int64_t start = k_uptime_ticks();
+
+            for (int i = 0; i <= fade.steps; i++)
             {
-                float t = (float)i / steps;                                  // Normalized time in [0, 1]
-                float eased = ease_in_out(t);                                // Eased time for smoother progression
-                float interpolated = req.from + (req.to - req.from) * eased; // Interpolated value
-                uint8_t brightness = (uint8_t)(interpolated + 0.5f);         // Rounded to nearest integer
+                uint8_t brightness = brightness_fade_step(&fade, i);
 
                 // Only send update if brightness actually changed
                 if (brightness != last_applied)
@@ -268,7 +257,10 @@ void fade_thread(void)
                     last_applied = brightness;
                 }
 
-                k_usleep(delay_us); // Sleep before next step to pace the fade
+                if (i < fade.steps)
+                {
+                    k_sleep(K_TIMEOUT_ABS_TICKS(start + k_ms_to_ticks_ceil64(brightness_fade_deadline_ms(&fade, i + 1))));
+                }
             }
 
             // safeguard to ensure the target value is set at the end
@@ -276,12 +268,13 @@ void fade_thread(void)
             {
                 apply_brightness(req.to);
             }
+            LOG_INF("Screen brightness faded from %d to %d", req.from, req.to);
         }
     }
 }
 
 // Launch the fade thread with 768 bytes of stack, medium priority (6)
-// 512 was too small for logging, math (float, int), small loop, few stack-local variables
+// 512 was too small for logging, small loop, few stack-local variables
 // 768 is just a guess, optimization is possible, probably
 K_THREAD_DEFINE(fade_tid, 768, fade_thread, NULL, NULL, NULL, 6, 0, 0);
 
@@ -378,7 +371,7 @@ void screen_idle_thread(void)
 
 K_THREAD_DEFINE(screen_idle_tid, 512, screen_idle_thread, NULL, NULL, NULL, 7, 0, 0);
 
-void brightness_wake_screen_on_reconnect(void)
+bool brightness_wake_screen_on_reconnect(void)
 {
     if (!screen_on)
     {
@@ -390,13 +383,53 @@ void brightness_wake_screen_on_reconnect(void)
         last_activity = k_uptime_get();
 
         k_wakeup(screen_idle_tid);
+        return true;
     }
-    else
+
+    LOG_DBG("Peripheral reconnected but screen already on");
+    return false;
+}
+
+#if IS_ENABLED(CONFIG_BT) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+
+static int64_t peripheral_link_up_ticks;
+
+// The screen state is shared with the key listener, which runs on the system work queue where ZMK
+// raises its events. The connection callback runs in the Bluetooth thread, so it only hands over.
+static void peripheral_wake(struct k_work *work)
+{
+    if (brightness_wake_screen_on_reconnect())
+    {
+        LOG_INF("Screen on %lld us after the split peripheral link came up",
+                k_ticks_to_us_floor64(k_uptime_ticks() - peripheral_link_up_ticks));
+    }
+}
+
+static K_WORK_DEFINE(peripheral_wake_work, peripheral_wake);
+
+// Wake the screen as soon as a split peripheral link comes up instead of waiting for its
+// first battery report, which can take up to the battery reporting interval.
+// Links where the dongle is the central are the split peripherals, host links are skipped.
+static void peripheral_connected(struct bt_conn *conn, uint8_t err)
+{
+    struct bt_conn_info info;
+
+    if (err || bt_conn_get_info(conn, &info) != 0 || info.role != BT_CONN_ROLE_CENTRAL)
     {
-        LOG_DBG("Peripheral reconnected but screen already on");
+        return;
     }
+
+    peripheral_link_up_ticks = k_uptime_ticks();
+    LOG_DBG("Split peripheral link up at %lld ms", k_uptime_get());
+    k_work_submit(&peripheral_wake_work);
 }
 
+BT_CONN_CB_DEFINE(dongle_screen_conn_callbacks) = {
+    .connected = peripheral_connected,
+};
+
+#endif // IS_ENABLED(CONFIG_BT) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+
 #endif
 
 // --- Brightness control via keyboard ---
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 /**
  * @brief Wake the screen when a peripheral reconnects
- * Called by battery widget when it detects a peripheral reconnection
+ * Called on the system work queue when a split peripheral link is established
+ * @return true if the screen was off and is turned on
  */
-void brightness_wake_screen_on_reconnect(void);
\ No newline at end of file
+bool brightness_wake_screen_on_reconnect(void);
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <stdlib.h>
+
+#include "brightness_fade.h"
+
+// The backlight duty cycle is linear in luminance, but the eye sees lightness, which is roughly the
+// cube root of it. Fades are interpolated in CIE 1976 L* lightness so every step looks equally large.
+// L* x 100 of every brightness percentage: L* = 116 * cbrt(Y) - 16, or 903.3 * Y for Y <= 0.008856.
+const uint16_t brightness_lightness[101] = {
+    0, 899, 1549, 2004, 2367, 2673, 2941, 3181, 3398, 3598,
+    3784, 3958, 4122, 4276, 4423, 4563, 4697, 4826, 4950, 5069,
+    5184, 5295, 5403, 5507, 5609, 5708, 5804, 5897, 5989, 6078,
+    6165, 6251, 6334, 6416, 6496, 6575, 6652, 6728, 6802, 6875,
+    6947, 7018, 7087, 7155, 7223, 7289, 7355, 7419, 7482, 7545,
+    7607, 7668, 7728, 7787, 7846, 7904, 7961, 8018, 8074, 8129,
+    8184, 8238, 8291, 8344, 8397, 8448, 8500, 8550, 8601, 8650,
+    8700, 8749, 8797, 8845, 8892, 8939, 8986, 9032, 9078, 9123,
+    9168, 9213, 9257, 9301, 9345, 9388, 9431, 9474, 9516, 9558,
+    9600, 9641, 9682, 9723, 9763, 9803, 9843, 9883, 9922, 9961,
+    10000,
+};
+
+// Cubic ease-in-out in Q15, sampled at FADE_EASE_SEGMENTS + 1 points of the fade.
+// Provides a natural "S-curve" animation effect: starts slow, accelerates, then slows again.
+const uint16_t fade_ease[FADE_EASE_SEGMENTS + 1] = {
+    0, 4, 32, 108, 256, 500, 864, 1372, 2048, 2916, 4000,
+    5324, 6912, 8788, 10976, 13500, 16384, 19268, 21792, 23980, 25856, 27444,
+    28768, 29852, 30720, 31396, 31904, 32268, 32512, 32660, 32736, 32764, 32768,
+};
+
+int32_t fade_eased(int i, int steps)
+{
+    uint32_t pos = ((uint32_t)i * FADE_EASE_SEGMENTS << 8) / steps; // Sample index in Q8
+    uint32_t index = pos >> 8;
+
+    if (index >= FADE_EASE_SEGMENTS)
+        return FADE_EASE_ONE;
+    return fade_ease[index] + (((fade_ease[index + 1] - fade_ease[index]) * (pos & 0xff)) >> 8);
+}
+
+uint8_t brightness_from_lightness(int32_t lightness)
+{
+    uint8_t low = 0;
+    uint8_t high = ARRAY_SIZE(brightness_lightness) - 1;
+
+    // Largest percentage whose lightness is not above the given one
+    while (low < high)
+    {
+        uint8_t mid = (low + high + 1) / 2;
+        if (brightness_lightness[mid] <= lightness)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    if (low + 1 < ARRAY_SIZE(brightness_lightness) &&
+        brightness_lightness[low + 1] - lightness < lightness - brightness_lightness[low])
+        return low + 1;
+    return low;
+}
+
+void brightness_fade_plan(struct brightness_fade *fade, uint8_t from, uint8_t to)
+{
+    int diff = abs(to - from);
+
+    fade->from_lightness = brightness_lightness[from];
+    fade->lightness_diff = brightness_lightness[to] - fade->from_lightness;
+    fade->steps = CLAMP(diff * 2, 6, 32);                  // More steps for smoother fades over large differences
+    fade->total_duration_ms = CLAMP(diff * 20, 500, 1000); // 20ms per level as baseline
+}
+
+uint8_t brightness_fade_step(const struct brightness_fade *fade, int i)
+{
+    return brightness_from_lightness(fade->from_lightness +
+                                     ((fade->lightness_diff * fade_eased(i, fade->steps) + FADE_EASE_ONE / 2) >> 15));
+}
+
+uint32_t brightness_fade_deadline_ms(const struct brightness_fade *fade, int i)
+{
+    return (uint32_t)fade->total_duration_ms * i / fade->steps;
+}
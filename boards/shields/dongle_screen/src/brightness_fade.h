@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// L* x 100 of every brightness percentage, the backlight duty cycle is linear in luminance
+extern const uint16_t brightness_lightness[101];
+
+// Cubic ease-in-out in Q15, sampled at FADE_EASE_SEGMENTS + 1 points of the fade
+#define FADE_EASE_SEGMENTS 32
+#define FADE_EASE_ONE (1 << 15)
+extern const uint16_t fade_ease[FADE_EASE_SEGMENTS + 1];
+
+/**
+ * @brief Eased progress of step i of steps in Q15, linearly interpolated between the samples
+ */
+int32_t fade_eased(int i, int steps);
+
+/**
+ * @brief Brightness percentage closest to a lightness, exact for the values of the table
+ */
+uint8_t brightness_from_lightness(int32_t lightness);
+
+// A fade between two brightness percentages, interpolated in perceived lightness
+struct brightness_fade
+{
+    int32_t from_lightness; // L* x 100 of the start
+    int32_t lightness_diff; // L* x 100 from the start to the target
+    uint16_t steps;         // Steps after the start, the last one reaches the target
+    uint16_t total_duration_ms;
+};
+
+/**
+ * @brief Plan a fade: more steps for larger differences and 20 ms per percent, within 500 to 1000 ms
+ * @param from Starting brightness percentage, 0 to 100
+ * @param to Target brightness percentage, 0 to 100
+ */
+void brightness_fade_plan(struct brightness_fade *fade, uint8_t from, uint8_t to);
+
+/**
+ * @brief Brightness percentage of step i, 0 is the start and fade->steps the target
+ *
+ * Both the lightness and the easing tables are monotonic, so a fade only ever moves
+ * towards its target.
+ */
+uint8_t brightness_fade_step(const struct brightness_fade *fade, int i);
+
+/**
+ * @brief Milliseconds from the start of the fade at which step i is due
+ *
+ * Deadlines are absolute, the time spent applying a step does not delay the following ones.
+ */
+uint32_t brightness_fade_deadline_ms(const struct brightness_fade *fade, int i);
@@ -6,75 +6,53 @@
 
 #include "custom_status_screen.h"
 
-#if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
-#include "widgets/output_status.h"
-static struct zmk_widget_output_status output_status_widget;
-#endif
-
-#if CONFIG_DONGLE_SCREEN_LAYER_ACTIVE
-#include "widgets/layer_status.h"
-static struct zmk_widget_layer_status layer_status_widget;
-#endif
+#include "widgets/widget_registry.h"
+#include "profiler.h"
 
-#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
-#include "widgets/battery_status.h"
-static struct zmk_widget_dongle_battery_status dongle_battery_status_widget;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_RLE_IMAGES)
+#include "rle_image.h"
 #endif
 
-#if CONFIG_DONGLE_SCREEN_WPM_ACTIVE
-#include "widgets/wpm_status.h"
-static struct zmk_widget_wpm_status wpm_status_widget;
-#endif
-
-#if CONFIG_DONGLE_SCREEN_MODIFIER_ACTIVE
-#include "widgets/mod_status.h"
-static struct zmk_widget_mod_status mod_widget;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PAGES)
+#include "page_manager.h"
 #endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-lv_style_t global_style;
+// Inherited by all widgets. Const styles stay in flash and are never copied to RAM.
+static const lv_style_const_prop_t screen_style_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_TEXT_LETTER_SPACE(1),
+    LV_STYLE_CONST_TEXT_LINE_SPACE(1),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(screen_style, screen_style_props);
 
 lv_obj_t *zmk_display_status_screen()
 {
     lv_obj_t *screen;
 
-    screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(screen, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(screen, 255, LV_PART_MAIN);
-
-    lv_style_init(&global_style);
-    // lv_style_set_text_font(&global_style, &lv_font_unscii_8); // ToDo: Font is not recognized
-    lv_style_set_text_color(&global_style, lv_color_white());
-    lv_style_set_text_letter_space(&global_style, 1);
-    lv_style_set_text_line_space(&global_style, 1);
-    lv_obj_add_style(screen, &global_style, LV_PART_MAIN);
-
-#if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
-    zmk_widget_output_status_init(&output_status_widget, screen);
-    lv_obj_align(zmk_widget_output_status_obj(&output_status_widget), LV_ALIGN_TOP_MID, 0, 10);
-#endif
-
-#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
-    zmk_widget_dongle_battery_status_init(&dongle_battery_status_widget, screen);
-    lv_obj_align(zmk_widget_dongle_battery_status_obj(&dongle_battery_status_widget), LV_ALIGN_BOTTOM_MID, 0, 0);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_RLE_IMAGES)
+    rle_image_decoder_init();
 #endif
 
-#if CONFIG_DONGLE_SCREEN_WPM_ACTIVE
-    zmk_widget_wpm_status_init(&wpm_status_widget, screen);
-    lv_obj_align(zmk_widget_wpm_status_obj(&wpm_status_widget), LV_ALIGN_TOP_LEFT, 20, 20);
-#endif
+    screen = lv_obj_create(NULL);
+    // Widgets sit at fixed positions, nothing ever scrolls
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+    // lv_font_unscii_8 as text_font: ToDo: Font is not recognized
+    lv_obj_add_style(screen, (lv_style_t *)&screen_style, LV_PART_MAIN);
 
-#if CONFIG_DONGLE_SCREEN_LAYER_ACTIVE
-    zmk_widget_layer_status_init(&layer_status_widget, screen);
-    lv_obj_align(zmk_widget_layer_status_obj(&layer_status_widget), LV_ALIGN_CENTER, 0, 0);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PAGES)
+    page_manager_init(screen);
+#else
+    widget_registry_create_all(screen);
 #endif
 
-#if CONFIG_DONGLE_SCREEN_MODIFIER_ACTIVE
-    zmk_widget_mod_status_init(&mod_widget, screen);
-    lv_obj_align(zmk_widget_mod_status_obj(&mod_widget), LV_ALIGN_CENTER, 0, 35);
-#endif
+    profiler_attach_display(lv_obj_get_disp(screen));
 
     return screen;
-}
\ No newline at end of file
+}
+
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/shell/shell.h>
+
+// Root of the `dongle_screen` shell command. Modules attach their own
+// subcommands with SHELL_SUBCMD_ADD((dongle_screen), ...).
+SHELL_SUBCMD_SET_CREATE(sub_dongle_screen, (dongle_screen));
+
+SHELL_CMD_REGISTER(dongle_screen, &sub_dongle_screen, "Dongle screen commands", NULL);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "page_manager.h"
+#include "profiler.h"
+#include "screen_layout.h"
+#include "widgets/widget_registry.h"
+
+// Page 0 is the status page made of the registered widgets, the registered pages follow
+static lv_obj_t *page_screen;
+static lv_obj_t *page_obj;
+static int active_page;
+static uint32_t last_build_us;
+
+// Page keys pressed since the last switch, the display queue applies them at once
+static atomic_t pending_steps;
+static uint32_t switch_event_cycles;
+
+static int page_count(void)
+{
+    int count;
+
+    STRUCT_SECTION_COUNT(dongle_screen_page, &count);
+    return count + 1;
+}
+
+static void page_delete_cb(lv_event_t *e)
+{
+    lv_timer_del(lv_event_get_user_data(e));
+}
+
+lv_timer_t *page_timer_create(lv_obj_t *page, lv_timer_cb_t cb, uint32_t period_ms)
+{
+    lv_timer_t *timer = lv_timer_create(cb, period_ms, page);
+
+    if (timer != NULL)
+    {
+        lv_obj_add_event_cb(page, page_delete_cb, LV_EVENT_DELETE, timer);
+    }
+    return timer;
+}
+
+uint32_t page_manager_last_build_us(void)
+{
+    return last_build_us;
+}
+
+static void page_build(int index)
+{
+    if (index == 0)
+    {
+        widget_registry_create_all(page_screen);
+        return;
+    }
+
+    struct dongle_screen_page *page;
+    STRUCT_SECTION_GET(dongle_screen_page, index - 1, &page);
+
+    page_obj = screen_layout_obj_create(page_screen);
+    // Follows the screen size when it is rotated
+    lv_obj_set_size(page_obj, lv_pct(100), lv_pct(100));
+    page->create(page_obj);
+}
+
+static void page_teardown(int index)
+{
+    if (index == 0)
+    {
+        widget_registry_destroy_all();
+        return;
+    }
+
+    // Also deletes the timers of the page
+    lv_obj_del(page_obj);
+    page_obj = NULL;
+}
+
+static void page_switch(struct k_work *work)
+{
+    int count = page_count();
+    int target = (active_page + (int)atomic_set(&pending_steps, 0)) % count;
+
+    if (target < 0)
+    {
+        target += count;
+    }
+    if (target == active_page)
+    {
+        return;
+    }
+
+    uint32_t start = k_cycle_get_32();
+    page_teardown(active_page);
+    page_build(target);
+    last_build_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    active_page = target;
+
+    // Completes once the new page was flushed to the panel
+    profiler_latency_begin(PROFILER_LATENCY_PAGE_SWITCH, switch_event_cycles);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size > 0)
+    {
+        LOG_INF("Page %d built in %u us, LVGL memory %u bytes used, %u bytes peak", target, last_build_us,
+                (unsigned int)(mon.total_size - mon.free_size), (unsigned int)mon.max_used);
+    }
+    else
+    {
+        LOG_INF("Page %d built in %u us", target, last_build_us);
+    }
+}
+
+K_WORK_DEFINE(page_switch_work, page_switch);
+
+void page_manager_init(lv_obj_t *screen)
+{
+    page_screen = screen;
+    active_page = 0;
+    page_build(active_page);
+}
+
+static int page_key_listener(const zmk_event_t *eh)
+{
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev == NULL || !ev->state || page_screen == NULL)
+    {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    if (ev->keycode == CONFIG_DONGLE_SCREEN_PAGE_NEXT_KEYCODE)
+    {
+        atomic_inc(&pending_steps);
+    }
+    else if (ev->keycode == CONFIG_DONGLE_SCREEN_PAGE_PREV_KEYCODE)
+    {
+        atomic_dec(&pending_steps);
+    }
+    else
+    {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    switch_event_cycles = k_cycle_get_32();
+    k_work_submit_to_queue(zmk_display_work_q(), &page_switch_work);
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(page_manager, page_key_listener);
+ZMK_SUBSCRIPTION(page_manager, zmk_keycode_state_changed);
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+/**
+ * @brief An additional screen page, shown after the status page
+ *
+ * Only the active page exists as LVGL objects. A page is built into an empty full screen
+ * container when it is switched to and deleted with it when another page is shown.
+ */
+struct dongle_screen_page
+{
+    const char *name;
+    void (*create)(lv_obj_t *page);
+};
+
+/**
+ * @brief Register a page, pages are switched through in priority order (10-99, two digits)
+ */
+#define DONGLE_SCREEN_PAGE_DEFINE(id, prio, create_fn)                                             \
+    const STRUCT_SECTION_ITERABLE_NAMED(dongle_screen_page, prio##_##id, id##_page) = {            \
+        .name = #id,                                                                               \
+        .create = create_fn,                                                                       \
+    }
+
+/**
+ * @brief Show the status page on the screen and start listening for the page keys
+ */
+void page_manager_init(lv_obj_t *screen);
+
+/**
+ * @brief Create a timer living as long as the page, its user_data is the page object
+ */
+lv_timer_t *page_timer_create(lv_obj_t *page, lv_timer_cb_t cb, uint32_t period_ms);
+
+/**
+ * @brief Time it took to delete the previous page and build the active one, in microseconds
+ */
+uint32_t page_manager_last_build_us(void);
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+
+#include "../page_manager.h"
+#include "../widgets/battery_status.h"
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_TREND)
+#include "../battery_trend.h"
+#endif
+
+// One line per source: level, and with the trend enabled the discharge rate and time to empty
+static int battery_page_line(char *buf, size_t size, uint8_t source)
+{
+    uint8_t level = battery_status_get_level(source);
+    uint8_t number = source + 1 - SOURCE_OFFSET;
+    int len = SOURCE_OFFSET && source == 0 ? snprintf(buf, size, "Dongle: ")
+                                           : snprintf(buf, size, "Part %u: ", number);
+
+    if (level == BATTERY_LEVEL_UNSEEN || level < 1)
+    {
+        return len + snprintf(buf + len, size - len, "--\n");
+    }
+
+    len += snprintf(buf + len, size - len, "%u%%", level);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_TREND)
+    int32_t rate = battery_trend_discharge_rate(source);
+    int32_t time_to_empty = battery_trend_time_to_empty_s(source);
+    if (rate > 0)
+    {
+        len += snprintf(buf + len, size - len, " -%d.%02d%%/h", rate / 100, rate % 100);
+    }
+    if (time_to_empty >= 0)
+    {
+        len += snprintf(buf + len, size - len, " ~%dh", time_to_empty / 3600);
+    }
+#endif
+
+    return len + snprintf(buf + len, size - len, "\n");
+}
+
+static void battery_page_refresh(lv_timer_t *timer)
+{
+    lv_obj_t *body = lv_obj_get_child(timer->user_data, 1);
+    char text[BATTERY_SOURCE_COUNT * 40];
+    size_t len = 0;
+
+    for (int i = 0; i < BATTERY_SOURCE_COUNT && len < sizeof(text); i++)
+    {
+        len += battery_page_line(text + len, sizeof(text) - len, i);
+    }
+    lv_label_set_text(body, text);
+}
+
+static void battery_page_create(lv_obj_t *page)
+{
+    lv_obj_t *title = lv_label_create(page);
+    lv_label_set_text_static(title, "Batteries");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+
+    lv_obj_t *body = lv_label_create(page);
+    lv_obj_align(body, LV_ALIGN_TOP_LEFT, 20, 50);
+
+    battery_page_refresh(page_timer_create(page, battery_page_refresh, 5000));
+}
+
+DONGLE_SCREEN_PAGE_DEFINE(battery, 20, battery_page_create);
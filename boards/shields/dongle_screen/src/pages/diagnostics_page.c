@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+
+#include "../page_manager.h"
+#include "../profiler.h"
+
+static void diagnostics_page_refresh(lv_timer_t *timer)
+{
+    lv_obj_t *body = lv_obj_get_child(timer->user_data, 1);
+    char text[200];
+    int len = snprintf(text, sizeof(text), "Page build: %u us\n", page_manager_last_build_us());
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size > 0)
+    {
+        len += snprintf(text + len, sizeof(text) - len, "LVGL mem: %u%% (peak %u B)\n", mon.used_pct,
+                        (unsigned int)mon.max_used);
+    }
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PROFILER)
+    snprintf(text + len, sizeof(text) - len, "Frames: %u\nRenders: %u\nGlyph cache: %u/%u",
+             profiler_get(PROFILER_FRAMES), profiler_get(PROFILER_WIDGET_RENDERS),
+             profiler_get(PROFILER_GLYPH_CACHE_HITS), profiler_get(PROFILER_GLYPH_CACHE_MISSES));
+#endif
+
+    lv_label_set_text(body, text);
+}
+
+static void diagnostics_page_create(lv_obj_t *page)
+{
+    lv_obj_t *title = lv_label_create(page);
+    lv_label_set_text_static(title, "Diagnostics");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+
+    lv_obj_t *body = lv_label_create(page);
+    lv_obj_align(body, LV_ALIGN_TOP_LEFT, 20, 50);
+
+    diagnostics_page_refresh(page_timer_create(page, diagnostics_page_refresh, 1000));
+}
+
+DONGLE_SCREEN_PAGE_DEFINE(diagnostics, 30, diagnostics_page_create);
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "../page_manager.h"
+
+// Counted all the time, the page only exists while it is shown
+static atomic_t key_presses;
+
+static int stats_key_listener(const zmk_event_t *eh)
+{
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev != NULL && ev->state)
+    {
+        atomic_inc(&key_presses);
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(page_stats, stats_key_listener);
+ZMK_SUBSCRIPTION(page_stats, zmk_keycode_state_changed);
+
+static void stats_page_refresh(lv_timer_t *timer)
+{
+    lv_obj_t *body = lv_obj_get_child(timer->user_data, 1);
+    uint32_t presses = atomic_get(&key_presses);
+    uint32_t uptime_s = k_uptime_get() / 1000;
+    uint32_t per_minute = uptime_s > 0 ? (uint64_t)presses * 60 / uptime_s : 0;
+
+    lv_label_set_text_fmt(body, "Keys: %u\nPer minute: %u\nUptime: %u:%02u:%02u", presses, per_minute,
+                          uptime_s / 3600, uptime_s / 60 % 60, uptime_s % 60);
+}
+
+static void stats_page_create(lv_obj_t *page)
+{
+    lv_obj_t *title = lv_label_create(page);
+    lv_label_set_text_static(title, "Key stats");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+
+    lv_obj_t *body = lv_label_create(page);
+    lv_obj_align(body, LV_ALIGN_TOP_LEFT, 20, 50);
+
+    stats_page_refresh(page_timer_create(page, stats_page_refresh, 1000));
+}
+
+DONGLE_SCREEN_PAGE_DEFINE(stats, 10, stats_page_create);
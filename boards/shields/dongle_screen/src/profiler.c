@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include "profiler.h"
+
+static atomic_t counters[PROFILER_COUNTER_COUNT];
+
+struct timing_stats
+{
+    bool pending;
+    uint32_t start;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint32_t total_us;
+    uint32_t count;
+};
+
+// Latencies and timers share the statistics, both guarded by timing_lock
+static struct timing_stats latencies[PROFILER_LATENCY_COUNT];
+static struct timing_stats timers[PROFILER_TIMER_COUNT];
+static struct k_spinlock timing_lock;
+static void (*chained_monitor_cb)(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+
+static const char *const counter_names[PROFILER_COUNTER_COUNT] = {
+    [PROFILER_WIDGET_RENDERS] = "widget_renders",
+    [PROFILER_SUPPRESSED_UPDATES] = "suppressed_updates",
+    [PROFILER_COALESCED_EVENTS] = "coalesced_events",
+    [PROFILER_FRAMES] = "frames",
+    [PROFILER_GLYPH_CACHE_HITS] = "glyph_cache_hits",
+    [PROFILER_GLYPH_CACHE_MISSES] = "glyph_cache_misses",
+};
+
+static const char *const latency_names[PROFILER_LATENCY_COUNT] = {
+    [PROFILER_LATENCY_LAYER_SWITCH] = "layer_switch",
+    [PROFILER_LATENCY_PAGE_SWITCH] = "page_switch",
+    [PROFILER_LATENCY_DIGIT_UPDATE] = "digit_update",
+    [PROFILER_LATENCY_ROTATE] = "rotate",
+};
+
+static const char *const timer_names[PROFILER_TIMER_COUNT] = {
+    [PROFILER_TIMER_MOD_ICONS_DRAW] = "mod_icons_draw",
+};
+
+static void timing_record(struct timing_stats *stats, uint32_t us)
+{
+    stats->last_us = us;
+    stats->max_us = MAX(stats->max_us, us);
+    stats->total_us += us;
+    stats->count++;
+}
+
+void profiler_count(enum profiler_counter counter)
+{
+    if (counter < PROFILER_COUNTER_COUNT)
+    {
+        atomic_inc(&counters[counter]);
+    }
+}
+
+uint32_t profiler_get(enum profiler_counter counter)
+{
+    if (counter >= PROFILER_COUNTER_COUNT)
+    {
+        return 0;
+    }
+    return (uint32_t)atomic_get(&counters[counter]);
+}
+
+void profiler_reset(void)
+{
+    for (int i = 0; i < PROFILER_COUNTER_COUNT; i++)
+    {
+        atomic_clear(&counters[i]);
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+    memset(latencies, 0, sizeof(latencies));
+    memset(timers, 0, sizeof(timers));
+    k_spin_unlock(&timing_lock, key);
+}
+
+void profiler_latency_begin(enum profiler_latency latency, uint32_t event_cycles)
+{
+    if (latency >= PROFILER_LATENCY_COUNT)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+    // A newer event before the flush restarts the measurement
+    latencies[latency].pending = true;
+    latencies[latency].start = event_cycles;
+    k_spin_unlock(&timing_lock, key);
+}
+
+void profiler_latency_record(enum profiler_latency latency, uint32_t event_cycles)
+{
+    uint32_t now = k_cycle_get_32();
+
+    if (latency >= PROFILER_LATENCY_COUNT)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+    timing_record(&latencies[latency], k_cyc_to_us_floor32(now - event_cycles));
+    k_spin_unlock(&timing_lock, key);
+}
+
+void profiler_timer_add(enum profiler_timer timer, uint32_t cycles)
+{
+    if (timer >= PROFILER_TIMER_COUNT)
+    {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+    timing_record(&timers[timer], k_cyc_to_us_floor32(cycles));
+    k_spin_unlock(&timing_lock, key);
+}
+
+// Called by LVGL after every refresh, once all areas were flushed to the display
+static void profiler_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    uint32_t now = k_cycle_get_32();
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+
+    for (int i = 0; i < PROFILER_LATENCY_COUNT; i++)
+    {
+        struct timing_stats *stats = &latencies[i];
+
+        if (!stats->pending)
+        {
+            continue;
+        }
+
+        stats->pending = false;
+        timing_record(stats, k_cyc_to_us_floor32(now - stats->start));
+        LOG_DBG("%s latency %u us", latency_names[i], stats->last_us);
+    }
+
+    k_spin_unlock(&timing_lock, key);
+
+    if (chained_monitor_cb != NULL)
+    {
+        chained_monitor_cb(drv, time, px);
+    }
+}
+
+void profiler_attach_display(lv_disp_t *disp)
+{
+    if (disp == NULL || disp->driver->monitor_cb == profiler_monitor_cb)
+    {
+        return;
+    }
+
+    chained_monitor_cb = disp->driver->monitor_cb;
+    disp->driver->monitor_cb = profiler_monitor_cb;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+static void print_timing(const struct shell *sh, const char *name, const struct timing_stats *stats)
+{
+    shell_print(sh, "%-24s last %u us, max %u us, avg %u us (%u samples)", name, stats->last_us,
+                stats->max_us, stats->count ? stats->total_us / stats->count : 0, stats->count);
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    for (int i = 0; i < PROFILER_COUNTER_COUNT; i++)
+    {
+        shell_print(sh, "%-24s %u", counter_names[i], profiler_get(i));
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&timing_lock);
+    struct timing_stats latency_snapshot[PROFILER_LATENCY_COUNT];
+    struct timing_stats timer_snapshot[PROFILER_TIMER_COUNT];
+    memcpy(latency_snapshot, latencies, sizeof(latency_snapshot));
+    memcpy(timer_snapshot, timers, sizeof(timer_snapshot));
+    k_spin_unlock(&timing_lock, key);
+
+    for (int i = 0; i < PROFILER_LATENCY_COUNT; i++)
+    {
+        print_timing(sh, latency_names[i], &latency_snapshot[i]);
+    }
+    for (int i = 0; i < PROFILER_TIMER_COUNT; i++)
+    {
+        print_timing(sh, timer_names[i], &timer_snapshot[i]);
+    }
+    return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+    profiler_reset();
+    shell_print(sh, "Profiler counters reset");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stats,
+                               SHELL_CMD(reset, NULL, "Reset all counters and timings", cmd_stats_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((dongle_screen), stats, &sub_stats, "Show display profiler counters and timings", cmd_stats, 1, 0);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Counters collected by the display profiler
+ */
+enum profiler_counter
+{
+    PROFILER_WIDGET_RENDERS,     // Widget update callbacks that actually touched LVGL objects
+    PROFILER_SUPPRESSED_UPDATES, // Widget updates skipped because the state did not change
+    PROFILER_COALESCED_EVENTS,   // Widget state changes merged into an already pending frame
+    PROFILER_FRAMES,             // Frames run by the render scheduler
+    PROFILER_GLYPH_CACHE_HITS,   // Glyph bitmaps served from the glyph cache
+    PROFILER_GLYPH_CACHE_MISSES, // Glyph bitmaps decoded from the font and added to the glyph cache
+    PROFILER_COUNTER_COUNT,
+};
+
+/**
+ * @brief Event-to-glass latencies, from the input event until its frame was flushed to the panel
+ */
+enum profiler_latency
+{
+    PROFILER_LATENCY_LAYER_SWITCH,
+    PROFILER_LATENCY_PAGE_SWITCH,
+    PROFILER_LATENCY_DIGIT_UPDATE, // From a digit_display change until its cells are on the panel
+    PROFILER_LATENCY_ROTATE,       // From the rotate request until the rotated screen was redrawn
+    PROFILER_LATENCY_COUNT,
+};
+
+/**
+ * @brief Durations of a piece of drawing work, measured in place
+ */
+enum profiler_timer
+{
+    PROFILER_TIMER_MOD_ICONS_DRAW, // Drawing the modifier icons, per draw pass
+    PROFILER_TIMER_COUNT,
+};
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PROFILER)
+
+/**
+ * @brief Increment a profiler counter, safe to call from any context
+ */
+void profiler_count(enum profiler_counter counter);
+
+/**
+ * @brief Read the current value of a profiler counter
+ */
+uint32_t profiler_get(enum profiler_counter counter);
+
+/**
+ * @brief Reset all profiler counters to zero
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Start a latency measurement after a widget was redrawn for an event
+ *
+ * The measurement completes when the next frame was flushed to the panel.
+ * @param event_cycles k_cycle_get_32() at the time the event was raised
+ */
+void profiler_latency_begin(enum profiler_latency latency, uint32_t event_cycles);
+
+/**
+ * @brief Record a latency right away, for updates written to the panel without LVGL
+ * @param event_cycles k_cycle_get_32() at the time the event was raised
+ */
+void profiler_latency_record(enum profiler_latency latency, uint32_t event_cycles);
+
+/**
+ * @brief Add one measured duration to a timer
+ * @param cycles Duration in k_cycle_get_32() cycles
+ */
+void profiler_timer_add(enum profiler_timer timer, uint32_t cycles);
+
+/**
+ * @brief Hook the flush monitor of the display, called once the screen was created
+ */
+void profiler_attach_display(lv_disp_t *disp);
+
+#else
+
+static inline void profiler_count(enum profiler_counter counter) { ARG_UNUSED(counter); }
+static inline uint32_t profiler_get(enum profiler_counter counter)
+{
+    ARG_UNUSED(counter);
+    return 0;
+}
+static inline void profiler_reset(void) {}
+static inline void profiler_latency_begin(enum profiler_latency latency, uint32_t event_cycles)
+{
+    ARG_UNUSED(latency);
+    ARG_UNUSED(event_cycles);
+}
+static inline void profiler_latency_record(enum profiler_latency latency, uint32_t event_cycles)
+{
+    ARG_UNUSED(latency);
+    ARG_UNUSED(event_cycles);
+}
+static inline void profiler_timer_add(enum profiler_timer timer, uint32_t cycles)
+{
+    ARG_UNUSED(timer);
+    ARG_UNUSED(cycles);
+}
+static inline void profiler_attach_display(lv_disp_t *disp) { ARG_UNUSED(disp); }
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "rle_image.h"
+
+BUILD_ASSERT(LV_COLOR_DEPTH == 16, "Run-length encoded images hold RGB565 pixels");
+
+#define RLE_RUN_FLAG 0x80
+#define RLE_COUNT_MASK 0x7F
+
+static const lv_img_dsc_t *rle_image_src(const void *src)
+{
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE)
+    {
+        return NULL;
+    }
+
+    const lv_img_dsc_t *img = src;
+    if (img->header.cf != RLE_IMAGE_CF_OPAQUE && img->header.cf != RLE_IMAGE_CF_ALPHA)
+    {
+        return NULL;
+    }
+    return img;
+}
+
+void rle_image_decode_row(const uint8_t *row, uint8_t px_size, lv_coord_t x, lv_coord_t len, uint8_t *out)
+{
+    lv_coord_t skip = x;
+
+    while (len > 0)
+    {
+        uint8_t tag = *row++;
+        lv_coord_t count = (tag & RLE_COUNT_MASK) + 1;
+        bool run = tag & RLE_RUN_FLAG;
+
+        // Packets before the requested part are only stepped over
+        if (skip >= count)
+        {
+            skip -= count;
+            row += run ? px_size : count * px_size;
+            continue;
+        }
+
+        lv_coord_t n = MIN(count - skip, len);
+
+        if (run)
+        {
+            for (lv_coord_t i = 0; i < n; i++)
+            {
+                memcpy(out, row, px_size);
+                out += px_size;
+            }
+            row += px_size;
+        }
+        else
+        {
+            memcpy(out, row + skip * px_size, n * px_size);
+            out += n * px_size;
+            row += count * px_size;
+        }
+
+        skip = 0;
+        len -= n;
+    }
+}
+
+static lv_res_t rle_image_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    const lv_img_dsc_t *img = rle_image_src(src);
+    if (img == NULL)
+    {
+        return LV_RES_INV;
+    }
+
+    *header = img->header;
+    // RAW tells LVGL the decoded lines are plain true color pixels
+    header->cf = img->header.cf == RLE_IMAGE_CF_ALPHA ? LV_IMG_CF_RAW_ALPHA : LV_IMG_CF_RAW;
+    return LV_RES_OK;
+}
+
+static lv_res_t rle_image_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    if (rle_image_src(dsc->src) == NULL)
+    {
+        return LV_RES_INV;
+    }
+
+    // No decoded copy, LVGL reads the image line by line
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t rle_image_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc, lv_coord_t x,
+                                    lv_coord_t y, lv_coord_t len, uint8_t *buf)
+{
+    const lv_img_dsc_t *img = dsc->src;
+    uint8_t px_size = img->header.cf == RLE_IMAGE_CF_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    if (y < 0 || y >= img->header.h || x < 0 || x + len > img->header.w)
+    {
+        return LV_RES_INV;
+    }
+
+    uint32_t offset = sys_get_le32(&img->data[y * sizeof(uint32_t)]);
+    rle_image_decode_row(&img->data[offset], px_size, x, len, buf);
+    return LV_RES_OK;
+}
+
+void rle_image_decoder_init(void)
+{
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    if (decoder == NULL)
+    {
+        LOG_ERR("Could not register the RLE image decoder");
+        return;
+    }
+
+    lv_img_decoder_set_info_cb(decoder, rle_image_info);
+    lv_img_decoder_set_open_cb(decoder, rle_image_open);
+    lv_img_decoder_set_read_line_cb(decoder, rle_image_read_line);
+}
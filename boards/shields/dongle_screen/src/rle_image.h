@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+// Color formats of run-length encoded images, see scripts/rle_image.py for the data layout
+#define RLE_IMAGE_CF_OPAQUE LV_IMG_CF_USER_ENCODED_0 // RGB565
+#define RLE_IMAGE_CF_ALPHA LV_IMG_CF_USER_ENCODED_1  // RGB565 followed by an alpha byte
+
+/**
+ * @brief Register the LVGL image decoder for run-length encoded images
+ *
+ * The images are decoded line by line straight into LVGL's line buffer, only the requested
+ * part of a row is decoded and no full size copy of the image is ever made.
+ * Must be called after lv_init().
+ */
+void rle_image_decoder_init(void);
+
+/**
+ * @brief Decode len pixels of an encoded row, starting at pixel x
+ * @param px_size Bytes per pixel, 2 for opaque and 3 for images with alpha
+ */
+void rle_image_decode_row(const uint8_t *row, uint8_t px_size, lv_coord_t x, lv_coord_t len, uint8_t *out);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+
+#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
+#include "widgets/battery_status.h"
+#endif
+
+// Screen layout resolved at compile time. Every widget gets a fixed box in screen coordinates for
+// each orientation, SCREEN_LAYOUT_<WIDGET> expands to both boxes, each "x, y, width, height".
+// The panel size comes from the chosen display in the devicetree.
+#define SCREEN_PANEL_WIDTH DT_PROP(DT_CHOSEN(zephyr_display), width)
+#define SCREEN_PANEL_HEIGHT DT_PROP(DT_CHOSEN(zephyr_display), height)
+
+enum screen_layout_index
+{
+    SCREEN_LAYOUT_UPRIGHT,   // 240x280 on the default panel
+    SCREEN_LAYOUT_LANDSCAPE, // Laying on the side, 280x240 on the default panel
+    SCREEN_LAYOUT_COUNT,
+};
+
+struct screen_box
+{
+    lv_coord_t x, y, width, height;
+};
+
+#define SCREEN_UPRIGHT_WIDTH SCREEN_PANEL_WIDTH
+#define SCREEN_UPRIGHT_HEIGHT SCREEN_PANEL_HEIGHT
+#define SCREEN_LANDSCAPE_WIDTH SCREEN_PANEL_HEIGHT
+#define SCREEN_LANDSCAPE_HEIGHT SCREEN_PANEL_WIDTH
+
+// Widgets are laid out for the same width in both orientations, centered on the wider side
+#define SCREEN_CONTENT_WIDTH MIN(SCREEN_PANEL_WIDTH, SCREEN_PANEL_HEIGHT)
+#define SCREEN_UPRIGHT_CONTENT_X ((SCREEN_UPRIGHT_WIDTH - SCREEN_CONTENT_WIDTH) / 2)
+#define SCREEN_LANDSCAPE_CONTENT_X ((SCREEN_LANDSCAPE_WIDTH - SCREEN_CONTENT_WIDTH) / 2)
+
+// Boxes of one orientation, o is UPRIGHT or LANDSCAPE. The layer name is centered, the modifiers
+// right below it, the batteries at the bottom edge.
+#define SCREEN_BOX_OUTPUT(o) SCREEN_##o##_CONTENT_X, 10, SCREEN_CONTENT_WIDTH, 77
+#define SCREEN_BOX_LAYER(o) SCREEN_##o##_CONTENT_X, (SCREEN_##o##_HEIGHT - 48) / 2, SCREEN_CONTENT_WIDTH, 48
+#define SCREEN_BOX_MODIFIER(o) (SCREEN_##o##_WIDTH - 180) / 2, (SCREEN_##o##_HEIGHT - 40) / 2 + 35, 180, 40
+#define SCREEN_BOX_BATTERY(o)                                                                      \
+    SCREEN_##o##_CONTENT_X, SCREEN_##o##_HEIGHT - BATTERY_WIDGET_HEIGHT, SCREEN_CONTENT_WIDTH,     \
+        BATTERY_WIDGET_HEIGHT
+
+// The lock indicators sit right above the batteries, or at the bottom edge without them
+#if CONFIG_DONGLE_SCREEN_BATTERY_ACTIVE
+#define SCREEN_INDICATOR_BOTTOM BATTERY_WIDGET_HEIGHT
+#else
+#define SCREEN_INDICATOR_BOTTOM 0
+#endif
+#define SCREEN_BOX_INDICATOR(o) (SCREEN_##o##_WIDTH - 80) / 2, SCREEN_##o##_HEIGHT - SCREEN_INDICATOR_BOTTOM - 24, 80, 24
+
+#define SCREEN_LAYOUT_OUTPUT {SCREEN_BOX_OUTPUT(UPRIGHT)}, {SCREEN_BOX_OUTPUT(LANDSCAPE)}
+#define SCREEN_LAYOUT_WPM                                                                          \
+    {SCREEN_UPRIGHT_CONTENT_X + 20, 20, SCREEN_CONTENT_WIDTH - 20, 77},                             \
+        {SCREEN_LANDSCAPE_CONTENT_X, 20, SCREEN_CONTENT_WIDTH, 77}
+#define SCREEN_LAYOUT_LAYER {SCREEN_BOX_LAYER(UPRIGHT)}, {SCREEN_BOX_LAYER(LANDSCAPE)}
+#define SCREEN_LAYOUT_MODIFIER {SCREEN_BOX_MODIFIER(UPRIGHT)}, {SCREEN_BOX_MODIFIER(LANDSCAPE)}
+#define SCREEN_LAYOUT_BATTERY {SCREEN_BOX_BATTERY(UPRIGHT)}, {SCREEN_BOX_BATTERY(LANDSCAPE)}
+#define SCREEN_LAYOUT_INDICATOR {SCREEN_BOX_INDICATOR(UPRIGHT)}, {SCREEN_BOX_INDICATOR(LANDSCAPE)}
+
+/**
+ * @brief Layout of the current orientation, changes when the screen is rotated at runtime
+ */
+enum screen_layout_index screen_layout_current(void);
+
+/**
+ * @brief Create a lean container: no styles, not scrollable, not clickable
+ *
+ * Position and size are set by screen_layout_place() or by the widget itself.
+ */
+static inline lv_obj_t *screen_layout_obj_create(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_CLICK_FOCUSABLE |
+                               LV_OBJ_FLAG_SCROLL_ON_FOCUS | LV_OBJ_FLAG_GESTURE_BUBBLE);
+    return obj;
+}
+
+/**
+ * @brief Put a widget into its box
+ */
+static inline void screen_layout_place(lv_obj_t *obj, const struct screen_box *box)
+{
+    lv_obj_set_pos(obj, box->x, box->y);
+    lv_obj_set_size(obj, box->width, box->height);
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "screen_layout.h"
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_ROTATE)
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "profiler.h"
+#include "widgets/widget_registry.h"
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_ROTATE) && IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// Orientation of the configuration, applied before LVGL starts
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_HORIZONTAL)
+#define SCREEN_DEFAULT_ORIENTATION                                                                 \
+    (IS_ENABLED(CONFIG_DONGLE_SCREEN_FLIPPED) ? DISPLAY_ORIENTATION_ROTATED_90                      \
+                                               : DISPLAY_ORIENTATION_ROTATED_270)
+#else
+#define SCREEN_DEFAULT_ORIENTATION                                                                 \
+    (IS_ENABLED(CONFIG_DONGLE_SCREEN_FLIPPED) ? DISPLAY_ORIENTATION_NORMAL                          \
+                                               : DISPLAY_ORIENTATION_ROTATED_180)
+#endif
+
+static enum display_orientation current_orientation = SCREEN_DEFAULT_ORIENTATION;
+
+enum screen_layout_index screen_layout_current(void)
+{
+    return current_orientation == DISPLAY_ORIENTATION_ROTATED_90 ||
+                   current_orientation == DISPLAY_ORIENTATION_ROTATED_270
+               ? SCREEN_LAYOUT_LANDSCAPE
+               : SCREEN_LAYOUT_UPRIGHT;
+}
+
+int disp_set_orientation(void)
+{
+    // Set the orientation
+    if (!device_is_ready(display))
+    {
+        return -EIO;
+    }
+
+    int ret = display_set_orientation(display, current_orientation);
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    return 0;
+}
+
+SYS_INIT(disp_set_orientation, APPLICATION, 60);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_ROTATE)
+
+// LVGL only swaps its resolution and coordinates, the panel rotates in hardware (sw_rotate is off)
+static const lv_disp_rot_t lvgl_rotations[] = {
+    [DISPLAY_ORIENTATION_NORMAL] = LV_DISP_ROT_NONE,
+    [DISPLAY_ORIENTATION_ROTATED_90] = LV_DISP_ROT_90,
+    [DISPLAY_ORIENTATION_ROTATED_180] = LV_DISP_ROT_180,
+    [DISPLAY_ORIENTATION_ROTATED_270] = LV_DISP_ROT_270,
+};
+
+// Latest requested orientation, the display queue applies it once
+static atomic_t target_orientation = ATOMIC_INIT(SCREEN_DEFAULT_ORIENTATION);
+static uint32_t rotate_event_cycles;
+
+// Reprograms the panel, moves the widgets into the boxes of the new layout and redraws the
+// whole screen right away, so the rotation costs exactly one full frame
+static void screen_rotate(struct k_work *work)
+{
+    enum display_orientation orientation = atomic_get(&target_orientation);
+
+    if (orientation == current_orientation)
+    {
+        return;
+    }
+
+    uint32_t start = k_cycle_get_32();
+
+    int ret = display_set_orientation(display, orientation);
+    if (ret < 0)
+    {
+        LOG_ERR("Failed to rotate the screen: %d", ret);
+        atomic_set(&target_orientation, current_orientation);
+        return;
+    }
+    current_orientation = orientation;
+
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_disp_set_rotation(disp, lvgl_rotations[orientation]);
+    widget_registry_place_all();
+    lv_refr_now(disp);
+
+    profiler_latency_record(PROFILER_LATENCY_ROTATE, rotate_event_cycles);
+    LOG_INF("Rotated to %d degrees in %u us", orientation * 90, k_cyc_to_us_floor32(k_cycle_get_32() - start));
+}
+
+K_WORK_DEFINE(screen_rotate_work, screen_rotate);
+
+static void screen_rotate_request(enum display_orientation orientation)
+{
+    atomic_set(&target_orientation, orientation);
+    rotate_event_cycles = k_cycle_get_32();
+    k_work_submit_to_queue(zmk_display_work_q(), &screen_rotate_work);
+}
+
+// Every press turns the screen by another 90 degrees
+static int rotate_key_listener(const zmk_event_t *eh)
+{
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev != NULL && ev->state && ev->keycode == CONFIG_DONGLE_SCREEN_ROTATE_KEYCODE &&
+        zmk_display_is_initialized())
+    {
+        screen_rotate_request((atomic_get(&target_orientation) + 1) % ARRAY_SIZE(lvgl_rotations));
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(screen_rotate, rotate_key_listener);
+ZMK_SUBSCRIPTION(screen_rotate, zmk_keycode_state_changed);
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+static int cmd_rotate(const struct shell *sh, size_t argc, char **argv)
+{
+    enum display_orientation orientation = (atomic_get(&target_orientation) + 1) % ARRAY_SIZE(lvgl_rotations);
+
+    if (argc > 1)
+    {
+        int degrees = atoi(argv[1]);
+        if (degrees < 0 || degrees > 270 || degrees % 90 != 0)
+        {
+            shell_error(sh, "Rotation must be 0, 90, 180 or 270");
+            return -EINVAL;
+        }
+        orientation = degrees / 90;
+    }
+
+    screen_rotate_request(orientation);
+    shell_print(sh, "Rotating to %d degrees", orientation * 90);
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((dongle_screen), rotate, NULL, "Rotate the screen: rotate [0|90|180|270]", cmd_rotate, 1, 1);
+
+#endif
+
+#endif
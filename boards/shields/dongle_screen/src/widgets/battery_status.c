@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/bluetooth/services/bas.h>
 
@@ -19,41 +22,78 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/usb.h>
 
 #include "battery_status.h"
-#include "../brightness.h"
-
-#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
-    #define SOURCE_OFFSET 1
-#else
-    #define SOURCE_OFFSET 0
+#include "widget_listener.h"
+#include "digit_display.h"
+#include "widget_registry.h"
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+#include "tile_renderer.h"
 #endif
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_TREND)
+#include "../battery_trend.h"
+#endif
+
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
+// Holds the levels of all sources, so coalescing events of different sources
+// into the same frame never drops an update.
 struct battery_state {
-    uint8_t source;
-    uint8_t level;
+    uint8_t level[BATTERY_SOURCE_COUNT];
     bool usb_present;
 };
 
+// Accumulated levels as reported by the events, BATTERY_LEVEL_UNSEEN until a source reports
+static struct battery_state reported_state = {
+    .level = {[0 ... BATTERY_SOURCE_COUNT - 1] = BATTERY_LEVEL_UNSEEN},
+};
+static struct k_spinlock reported_state_lock;
+
+// Slots narrower than the full size bar get a shorter bar. The rows are laid out in the header,
+// the screen layout reserves their height.
+#define BATTERY_WIDGET_WIDTH SCREEN_CONTENT_WIDTH
+#define BATTERY_SLOT_WIDTH (BATTERY_WIDGET_WIDTH / BATTERY_COLUMNS)
+
+#define BATTERY_BAR_WIDTH MIN(102, BATTERY_SLOT_WIDTH - 18)
+#define BATTERY_BAR_HEIGHT 5
+
+// Horizontal offset of a slot center from the widget center. A partially filled last row is centered.
+#define BATTERY_SLOT_ROW(i) ((i) / BATTERY_COLUMNS)
+#define BATTERY_SLOTS_IN_ROW(i)                                                                    \
+    MIN(BATTERY_COLUMNS, BATTERY_SOURCE_COUNT - BATTERY_SLOT_ROW(i) * BATTERY_COLUMNS)
+#define BATTERY_SLOT_X(i)                                                                          \
+    (((i) % BATTERY_COLUMNS) * BATTERY_SLOT_WIDTH + BATTERY_SLOT_WIDTH / 2 -                       \
+     BATTERY_SLOTS_IN_ROW(i) * BATTERY_SLOT_WIDTH / 2)
+
+// The time to empty estimate only fits next to the level in full size slots
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_TREND) && BATTERY_SLOT_WIDTH >= 120
+#define BATTERY_LABEL_TREND 1
+#else
+#define BATTERY_LABEL_TREND 0
+#endif
+
+// The level cells hold up to "100" or the "X" of a disconnected source
+#define BATTERY_LABEL_SLOTS 3
+
 struct battery_object {
     lv_obj_t *symbol;
-    lv_obj_t *label;
-} battery_objects[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET];
-    
-static lv_color_t battery_image_buffer[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET][102 * 5];
+    struct digit_display label;
+#if BATTERY_LABEL_TREND
+    // Plain label for the estimate (" ~5h"), its letters would widen every digit cell
+    lv_obj_t *trend;
+#endif
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+    struct tile bar;
+#endif
+} battery_objects[BATTERY_SOURCE_COUNT];
 
 // Peripheral reconnection tracking
 // ZMK sends battery events with level < 1 when peripherals disconnect
-static int8_t last_battery_levels[ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET];
-
-static void init_peripheral_tracking(void) {
-    for (int i = 0; i < (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET); i++) {
-        last_battery_levels[i] = -1; // -1 indicates never seen before
-    }
-}
+static int8_t last_battery_levels[BATTERY_SOURCE_COUNT] = {
+    [0 ... BATTERY_SOURCE_COUNT - 1] = -1, // -1 indicates never seen before
+};
 
 static bool is_peripheral_reconnecting(uint8_t source, uint8_t new_level) {
-    if (source >= (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET)) {
+    if (source >= BATTERY_SOURCE_COUNT) {
         return false;
     }
     
@@ -73,132 +113,449 @@ static bool is_peripheral_reconnecting(uint8_t source, uint8_t new_level) {
     return reconnecting;
 }
 
-static void draw_battery(lv_obj_t *canvas, uint8_t level, bool usb_present) {
-    
-    if (level < 1)
-    {
-        lv_canvas_fill_bg(canvas, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER);
+enum battery_level_class {
+    BATTERY_LEVEL_EMPTY,    // < 1, disconnected
+    BATTERY_LEVEL_LOW,      // <= 10
+    BATTERY_LEVEL_NORMAL,
+};
+
+static enum battery_level_class battery_level_class(int8_t level) {
+    if (level < 1) {
+        return BATTERY_LEVEL_EMPTY;
     } else if (level <= 10) {
-        lv_canvas_fill_bg(canvas, lv_palette_main(LV_PALETTE_YELLOW), LV_OPA_COVER);
-    } else {
-        lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+        return BATTERY_LEVEL_LOW;
     }
+    return BATTERY_LEVEL_NORMAL;
+}
 
-    
-    lv_draw_rect_dsc_t rect_fill_dsc;
-    lv_draw_rect_dsc_init(&rect_fill_dsc);
-    rect_fill_dsc.bg_color = lv_color_black();
+static lv_color_t battery_level_color(enum battery_level_class class) {
+    switch (class) {
+    case BATTERY_LEVEL_EMPTY:
+        return lv_palette_main(LV_PALETTE_RED);
+    case BATTERY_LEVEL_LOW:
+        return lv_palette_main(LV_PALETTE_YELLOW);
+    default:
+        return lv_color_white();
+    }
+}
 
+// Label colors as const styles in flash, a class change swaps the style instead of setting
+// a local color property. Same colors as battery_level_color().
+static const lv_style_const_prop_t level_empty_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xF4, 0x43, 0x36)), // LV_PALETTE_RED
+    LV_STYLE_PROP_INV,
+};
+static const lv_style_const_prop_t level_low_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xEB, 0x3B)), // LV_PALETTE_YELLOW
+    LV_STYLE_PROP_INV,
+};
+static const lv_style_const_prop_t level_normal_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(level_empty_style, level_empty_props);
+static LV_STYLE_CONST_INIT(level_low_style, level_low_props);
+static LV_STYLE_CONST_INIT(level_normal_style, level_normal_props);
+
+static lv_style_t *battery_level_style(enum battery_level_class class) {
+    switch (class) {
+    case BATTERY_LEVEL_EMPTY:
+        return (lv_style_t *)&level_empty_style;
+    case BATTERY_LEVEL_LOW:
+        return (lv_style_t *)&level_low_style;
+    default:
+        return (lv_style_t *)&level_normal_style;
+    }
+}
+
+// End (exclusive) of the filled part of the bar interior. The interior spans all but the
+// last column, which is the always filled battery tip. Empty and full batteries are filled completely.
+static lv_coord_t battery_fill_end(int8_t level) {
+    if (level < 1 || level > 99) {
+        return BATTERY_BAR_WIDTH - 1;
+    }
+    return MAX(1, level * (BATTERY_BAR_WIDTH - 1) / 100);
+}
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
 
-    lv_canvas_set_px(canvas, 0, 0, lv_color_black());
-    lv_canvas_set_px(canvas, 0, 4, lv_color_black());
-    lv_canvas_set_px(canvas, 101, 0, lv_color_black());
-    lv_canvas_set_px(canvas, 101, 4, lv_color_black());
+// Written to the panel directly, so unlike the LVGL draw the empty part is cleared as well
+static void battery_bar_repaint(struct tile *tile) {
+    struct battery_object *object = CONTAINER_OF(tile, struct battery_object, bar);
+    int8_t level = last_battery_levels[object - battery_objects];
+    lv_color_t color = battery_level_color(battery_level_class(level));
 
-    if (level <= 99 && level > 0)
-    {
-        lv_canvas_draw_rect(canvas, level, 1, 100 - level, 3, &rect_fill_dsc);
-        lv_canvas_set_px(canvas, 100, 1, lv_color_black());
-        lv_canvas_set_px(canvas, 100, 2, lv_color_black());
-        lv_canvas_set_px(canvas, 100, 3, lv_color_black());
+    tile_fill(tile, 0, 0, BATTERY_BAR_WIDTH, BATTERY_BAR_HEIGHT, lv_color_black());
+    tile_fill(tile, 1, 0, BATTERY_BAR_WIDTH - 2, 1, color);
+    tile_fill(tile, 1, BATTERY_BAR_HEIGHT - 1, BATTERY_BAR_WIDTH - 2, 1, color);
+    tile_fill(tile, BATTERY_BAR_WIDTH - 1, 1, 1, BATTERY_BAR_HEIGHT - 2, color);
+    tile_fill(tile, 0, 1, battery_fill_end(level), BATTERY_BAR_HEIGHT - 2, color);
+}
+
+// Same as the LVGL variant below: the whole bar on a color change, otherwise only the columns
+// between the old and the new fill end. Until the bar is shown its repaint draws it.
+static void battery_bar_update(uint8_t source, int8_t old_level, int8_t new_level) {
+    struct tile *bar = &battery_objects[source].bar;
+
+    if (!tile_shown(bar)) {
+        return;
     }
-    
+
+    if (old_level < 0 || battery_level_class(old_level) != battery_level_class(new_level)) {
+        battery_bar_repaint(bar);
+        return;
+    }
+
+    lv_coord_t old_end = battery_fill_end(old_level);
+    lv_coord_t new_end = battery_fill_end(new_level);
+    if (old_end == new_end) {
+        return;
+    }
+
+    lv_color_t color = new_end > old_end ? battery_level_color(battery_level_class(new_level)) : lv_color_black();
+    tile_fill(bar, MIN(old_end, new_end), 1, abs(new_end - old_end), BATTERY_BAR_HEIGHT - 2, color);
 }
 
-static void set_battery_symbol(lv_obj_t *widget, struct battery_state state) {
-    if (state.source >= ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET) {
+#else
+
+// Draws the bar straight into the draw buffer, so no per-source pixel buffer is needed.
+// Only colored parts are drawn, the empty part is left to the black screen background.
+static void battery_bar_draw_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    uint8_t source = (uintptr_t)lv_event_get_user_data(e);
+    int8_t level = last_battery_levels[source];
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = battery_level_color(battery_level_class(level));
+
+    // Frame without the corner pixels, the tip and the filled part
+    const lv_area_t parts[] = {
+        {coords.x1 + 1, coords.y1, coords.x2 - 1, coords.y1},
+        {coords.x1 + 1, coords.y2, coords.x2 - 1, coords.y2},
+        {coords.x2, coords.y1 + 1, coords.x2, coords.y2 - 1},
+        {coords.x1, coords.y1 + 1, coords.x1 + battery_fill_end(level) - 1, coords.y2 - 1},
+    };
+
+    for (int i = 0; i < ARRAY_SIZE(parts); i++) {
+        lv_draw_rect(draw_ctx, &dsc, &parts[i]);
+    }
+}
+
+// Invalidates only the part of the bar affected by a level change: the whole bar if the
+// color changes, otherwise just the columns between the old and the new fill end.
+static void battery_bar_update(uint8_t source, int8_t old_level, int8_t new_level) {
+    lv_obj_t *bar = battery_objects[source].symbol;
+
+    if (old_level < 0 || battery_level_class(old_level) != battery_level_class(new_level)) {
+        lv_obj_invalidate(bar);
+        return;
+    }
+
+    lv_coord_t old_end = battery_fill_end(old_level);
+    lv_coord_t new_end = battery_fill_end(new_level);
+    if (old_end == new_end) {
         return;
     }
-    
-    // Check for reconnection using the existing battery level mechanism
-    bool reconnecting = is_peripheral_reconnecting(state.source, state.level);
-    
-    // Update our tracking
-    last_battery_levels[state.source] = state.level;
 
+    lv_area_t coords;
+    lv_obj_get_coords(bar, &coords);
+
+    lv_area_t delta = {
+        .x1 = coords.x1 + MIN(old_end, new_end),
+        .y1 = coords.y1 + 1,
+        .x2 = coords.x1 + MAX(old_end, new_end) - 1,
+        .y2 = coords.y2 - 1,
+    };
+    lv_obj_invalidate_area(bar, &delta);
+}
 
-    // Wake screen on reconnection
-    if (reconnecting) {
-#if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0    
-        LOG_INF("Peripheral %d reconnected (battery: %d%%), requesting screen wake", 
-                state.source, state.level);
-        brightness_wake_screen_on_reconnect();
-#else 
-        LOG_INF("Peripheral %d reconnected (battery: %d%%)", 
-                state.source, state.level);
 #endif
+
+#if BATTERY_LABEL_TREND
+
+// Width reserved for the longest estimate, set when the widget is created
+static lv_coord_t battery_trend_width;
+
+// The level is centered in its slot, with an estimate both are centered together. The objects
+// are aligned to the widget, so they follow when the layout moves or resizes it.
+static void battery_label_align(uint8_t source, bool with_trend) {
+    struct battery_object *object = &battery_objects[source];
+    lv_coord_t label_width = object->label.slots * object->label.slot_width;
+    lv_coord_t y = BATTERY_SLOT_ROW(source) * BATTERY_ROW_HEIGHT;
+
+    lv_obj_align(object->label.obj, LV_ALIGN_TOP_MID,
+                 BATTERY_SLOT_X(source) - (with_trend ? battery_trend_width / 2 : 0), y);
+    lv_obj_align(object->trend, LV_ALIGN_TOP_MID, BATTERY_SLOT_X(source) + label_width / 2, y);
+}
+
+static void show_battery_trend(uint8_t source, const char *text) {
+    lv_obj_t *trend = battery_objects[source].trend;
+    const char *shown = lv_label_get_text(trend);
+
+    if (strcmp(shown, text) == 0) {
+        return;
     }
 
+    // Only appearing or disappearing moves the level
+    if ((shown[0] == '\0') != (text[0] == '\0')) {
+        battery_label_align(source, text[0] != '\0');
+    }
+    lv_label_set_text(trend, text);
+}
 
-    LOG_DBG("source: %d, level: %d, usb: %d", state.source, state.level, state.usb_present);
-    lv_obj_t *symbol = battery_objects[state.source].symbol;
-    lv_obj_t *label = battery_objects[state.source].label;
+#endif
 
-    draw_battery(symbol, state.level, state.usb_present);
-    
-    if (state.level > 0) {
-        lv_obj_set_style_text_color(label, lv_color_white(), 0);
-        lv_label_set_text_fmt(label, "%4u", state.level);
+static void set_battery_label_text(uint8_t source, const char *level_text, uint8_t level) {
+    struct battery_object *object = &battery_objects[source];
+
+    if (level_text != NULL) {
+        digit_display_set_text(&object->label, level_text);
     } else {
-        lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
-        lv_label_set_text(label, "X");
+        digit_display_set_value(&object->label, level);
     }
 
-    if (state.level < 1)
-    {
-        lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
-        lv_label_set_text(label, "X");
-    } else if (state.level <= 10) {
-        lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_YELLOW), 0);
-        lv_label_set_text_fmt(label, "%4u", state.level);
-    } else {
-        lv_obj_set_style_text_color(label, lv_color_white(), 0);
-        lv_label_set_text_fmt(label, "%4u", state.level);
+#if BATTERY_LABEL_TREND
+    int32_t tte = level_text == NULL ? battery_trend_time_to_empty_s(source) : -1;
+    char text[8] = "";
+
+    if (tte >= 3600) {
+        snprintf(text, sizeof(text), " ~%dh", MIN(tte / 3600, 999));
+    } else if (tte >= 0) {
+        snprintf(text, sizeof(text), " ~%dm", tte / 60);
+    }
+    show_battery_trend(source, text);
+#endif
+}
+
+// Draws a level change, previous_level < 0 for objects that were just created
+static void show_battery_level(uint8_t source, int8_t previous_level, uint8_t level) {
+    lv_obj_t *symbol = battery_objects[source].symbol;
+    struct digit_display *label = &battery_objects[source].label;
+
+    battery_bar_update(source, previous_level, level);
+
+    // Swap the label color style only when crossing a threshold, labels start out as normal
+    enum battery_level_class class = battery_level_class(level);
+    enum battery_level_class shown_class =
+        previous_level < 0 ? BATTERY_LEVEL_NORMAL : battery_level_class(previous_level);
+    if (shown_class != class) {
+        lv_obj_replace_style(label->obj, battery_level_style(shown_class), battery_level_style(class), 0);
+#if BATTERY_LABEL_TREND
+        lv_obj_replace_style(battery_objects[source].trend, battery_level_style(shown_class),
+                             battery_level_style(class), 0);
+#endif
     }
-    
-    
-    
-    lv_obj_clear_flag(symbol, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_move_foreground(symbol);
-    lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
-    lv_obj_move_foreground(label);
 
+    set_battery_label_text(source, class == BATTERY_LEVEL_EMPTY ? "X" : NULL, level);
+
+    if (previous_level < 0) {
+        lv_obj_clear_flag(symbol, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(label->obj, LV_OBJ_FLAG_HIDDEN);
+#if BATTERY_LABEL_TREND
+        lv_obj_clear_flag(battery_objects[source].trend, LV_OBJ_FLAG_HIDDEN);
+#endif
+    }
+}
+
+// Tracks a level change of a source, once per change no matter how many widgets show it
+// (or whether any is shown at all, e.g. while a page replaces the status screen)
+static void track_battery_level(uint8_t source, uint8_t level) {
+    // Check for reconnection using the existing battery level mechanism
+    bool reconnecting = is_peripheral_reconnecting(source, level);
+
+    // Update our tracking, this is also the level the bar is drawn with
+    int8_t previous_level = last_battery_levels[source];
+    last_battery_levels[source] = level;
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_TREND)
+    if (level < 1) {
+        battery_trend_reset(source);
+    } else if (level != previous_level) {
+        battery_trend_add_sample(source, level, k_uptime_get());
+    }
+#endif
+
+
+    // The screen is woken by the link layer connection already (see brightness.c),
+    // the first battery report after a reconnect can arrive much later.
+    if (reconnecting) {
+        LOG_INF("Peripheral %d reconnected (battery: %d%%) at %lld ms", 
+                source, level, k_uptime_get());
+    }
 }
 
 void battery_status_update_cb(struct battery_state state) {
-    struct zmk_widget_dongle_battery_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_battery_symbol(widget->obj, state); }
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        // Only redraw sources whose level changed since they were last drawn
+        if (state.level[i] == BATTERY_LEVEL_UNSEEN || (int8_t)state.level[i] == last_battery_levels[i]) {
+            continue;
+        }
+
+        int8_t previous_level = last_battery_levels[i];
+        track_battery_level(i, state.level[i]);
+
+        LOG_DBG("source: %d, level: %d, usb: %d", i, state.level[i], state.usb_present);
+
+        // The battery objects are shared, drawing them once covers every widget
+        if (!sys_slist_is_empty(&widgets)) {
+            show_battery_level(i, previous_level, state.level[i]);
+        }
+    }
+}
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_FILTER)
+
+// Reported levels jitter by about 1% around voltage thresholds. The shown level of each source
+// only follows the latest reported level once that left the hysteresis band and the shown level
+// was kept for the minimum dwell time. ZMK only reports changes, so a level held back by the dwell
+// is re-checked by a timer when the dwell ends instead of waiting for the next report.
+// Disconnects and color threshold changes always pass through immediately.
+#define BATTERY_FILTER_DWELL_MS (CONFIG_DONGLE_SCREEN_BATTERY_FILTER_DWELL_S * 1000)
+
+struct battery_filter {
+    int64_t shown_since;
+    uint8_t reported;
+    uint8_t shown;
+};
+
+static struct battery_filter battery_filters[BATTERY_SOURCE_COUNT] = {
+    [0 ... BATTERY_SOURCE_COUNT - 1] = {.shown = BATTERY_LEVEL_UNSEEN},
+};
+
+static int widget_dongle_battery_status_cb(const zmk_event_t *eh);
+
+static void battery_filter_recheck(struct k_work *work);
+
+K_WORK_DELAYABLE_DEFINE(battery_filter_work, battery_filter_recheck);
+
+// Called with reported_state_lock held
+static uint8_t battery_filter_settle(uint8_t source, int64_t now) {
+    struct battery_filter *filter = &battery_filters[source];
+
+    if (abs(filter->reported - filter->shown) <= CONFIG_DONGLE_SCREEN_BATTERY_FILTER_HYSTERESIS) {
+        return filter->shown;
+    }
+
+    int64_t remaining_ms = filter->shown_since + BATTERY_FILTER_DWELL_MS - now;
+    if (remaining_ms <= 0) {
+        filter->shown = filter->reported;
+        filter->shown_since = now;
+        return filter->shown;
+    }
+
+    // One timer for all sources, it has to fire for the one whose dwell ends first
+    k_ticks_t ticks = k_ms_to_ticks_ceil64(remaining_ms);
+    if (!k_work_delayable_is_pending(&battery_filter_work) ||
+        k_work_delayable_remaining_get(&battery_filter_work) > ticks) {
+        k_work_reschedule(&battery_filter_work, K_TICKS(ticks));
+    }
+    LOG_DBG("source: %d, level %d held back, showing %d", source, filter->reported, filter->shown);
+
+    return filter->shown;
+}
+
+static void battery_filter_recheck(struct k_work *work) {
+    k_spinlock_key_t key = k_spin_lock(&reported_state_lock);
+    int64_t now = k_uptime_get();
+
+    for (uint8_t i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        if (battery_filters[i].shown != BATTERY_LEVEL_UNSEEN) {
+            reported_state.level[i] = battery_filter_settle(i, now);
+        }
+    }
+    k_spin_unlock(&reported_state_lock, key);
+
+    // Picks up the settled levels, the listener drops the update if none changed
+    widget_dongle_battery_status_cb(NULL);
+}
+
+static uint8_t battery_filter_level(uint8_t source, uint8_t raw) {
+    struct battery_filter *filter = &battery_filters[source];
+    int64_t now = k_uptime_get();
+
+    filter->reported = raw;
+    if (filter->shown == BATTERY_LEVEL_UNSEEN || raw < 1 ||
+        battery_level_class(raw) != battery_level_class(filter->shown)) {
+        filter->shown = raw;
+        filter->shown_since = now;
+        return raw;
+    }
+
+    return battery_filter_settle(source, now);
 }
 
-static struct battery_state peripheral_battery_status_get_state(const zmk_event_t *eh) {
+#else
+
+static uint8_t battery_filter_level(uint8_t source, uint8_t raw) { return raw; }
+
+#endif /* IS_ENABLED(CONFIG_DONGLE_SCREEN_BATTERY_FILTER) */
+
+static void peripheral_battery_status_update_state(const zmk_event_t *eh) {
     const struct zmk_peripheral_battery_state_changed *ev = as_zmk_peripheral_battery_state_changed(eh);
-    return (struct battery_state){
-        .source = ev->source + SOURCE_OFFSET,
-        .level = ev->state_of_charge,
-    };
+    uint8_t source = ev->source + SOURCE_OFFSET;
+
+    if (source < BATTERY_SOURCE_COUNT) {
+        reported_state.level[source] = battery_filter_level(source, ev->state_of_charge);
+    }
 }
 
-static struct battery_state central_battery_status_get_state(const zmk_event_t *eh) {
-    const struct zmk_battery_state_changed *ev = as_zmk_battery_state_changed(eh);
-    return (struct battery_state) {
-        .source = 0,
-        .level = (ev != NULL) ? ev->state_of_charge : zmk_battery_state_of_charge(),
+#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
+
+static void central_battery_status_update_state(const zmk_event_t *eh) {
+    const struct zmk_battery_state_changed *ev = (eh != NULL) ? as_zmk_battery_state_changed(eh) : NULL;
+
+    reported_state.level[0] =
+        battery_filter_level(0, (ev != NULL) ? ev->state_of_charge : zmk_battery_state_of_charge());
 #if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
-        .usb_present = zmk_usb_is_powered(),
+    reported_state.usb_present = zmk_usb_is_powered();
 #endif /* IS_ENABLED(CONFIG_USB_DEVICE_STACK) */
-    };
 }
 
-static struct battery_state battery_status_get_state(const zmk_event_t *eh) { 
-    if (as_zmk_peripheral_battery_state_changed(eh) != NULL) {
-        return peripheral_battery_status_get_state(eh);
+#endif /* IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY) */
+
+static struct battery_state battery_status_get_state(const zmk_event_t *eh) {
+    k_spinlock_key_t key = k_spin_lock(&reported_state_lock);
+
+    if (eh == NULL) {
+        // Called on every (re-)init of the widget: keep what the events reported so far and only
+        // sample the dongle battery once, before its first event arrives
+#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
+        if (reported_state.level[0] == BATTERY_LEVEL_UNSEEN) {
+            central_battery_status_update_state(NULL);
+        }
+#endif /* IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY) */
+    } else if (as_zmk_peripheral_battery_state_changed(eh) != NULL) {
+        peripheral_battery_status_update_state(eh);
     } else {
-        return central_battery_status_get_state(eh);
+#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
+        central_battery_status_update_state(eh);
+#endif /* IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY) */
     }
+
+    struct battery_state state = reported_state;
+    k_spin_unlock(&reported_state_lock, key);
+
+    return state;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_dongle_battery_status, struct battery_state,
+uint8_t battery_status_get_level(uint8_t source) {
+    if (source >= BATTERY_SOURCE_COUNT) {
+        return BATTERY_LEVEL_UNSEEN;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&reported_state_lock);
+    uint8_t level = reported_state.level[source];
+    k_spin_unlock(&reported_state_lock, key);
+
+    return level;
+}
+
+DONGLE_SCREEN_WIDGET_LISTENER(widget_dongle_battery_status, struct battery_state,
                             battery_status_update_cb, battery_status_get_state)
 
 ZMK_SUBSCRIPTION(widget_dongle_battery_status, zmk_peripheral_battery_state_changed);
@@ -214,38 +571,79 @@ ZMK_SUBSCRIPTION(widget_dongle_battery_status, zmk_usb_conn_state_changed);
 #endif /* IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY) */
 
 int zmk_widget_dongle_battery_status_init(struct zmk_widget_dongle_battery_status *widget, lv_obj_t *parent) {
-    widget->obj = lv_obj_create(parent);
+    widget->obj = screen_layout_obj_create(parent);
 
-    lv_obj_set_size(widget->obj, 240, 40);
-    
-    for (int i = 0; i < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET; i++) {
-        lv_obj_t *image_canvas = lv_canvas_create(widget->obj);
-        lv_obj_t *battery_label = lv_label_create(widget->obj);
+#if BATTERY_LABEL_TREND
+    const lv_font_t *font = lv_obj_get_style_text_font(widget->obj, LV_PART_MAIN);
+    lv_point_t hours, minutes;
 
-        lv_canvas_set_buffer(image_canvas, battery_image_buffer[i], 102, 5, LV_IMG_CF_TRUE_COLOR);
+    lv_txt_get_size(&hours, " ~999h", font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&minutes, " ~59m", font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    battery_trend_width = MAX(hours.x, minutes.x);
+#endif
 
-        lv_obj_align(image_canvas, LV_ALIGN_BOTTOM_MID, -60 +(i * 120), -8);
-        lv_obj_align(battery_label, LV_ALIGN_TOP_MID, -60 +(i * 120), 0);
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        lv_obj_t *battery_bar = screen_layout_obj_create(widget->obj);
+        // Fixed cells, so a text change only invalidates the changed characters of this source
+        lv_obj_t *battery_label = digit_display_create(&battery_objects[i].label, widget->obj, NULL,
+                                                       BATTERY_LABEL_SLOTS, DIGIT_DISPLAY_ALIGN_CENTER);
+        digit_display_fit(&battery_objects[i].label, "X");
+
+        lv_obj_add_style(battery_label, battery_level_style(BATTERY_LEVEL_NORMAL), 0);
+        lv_obj_set_size(battery_bar, BATTERY_BAR_WIDTH, BATTERY_BAR_HEIGHT);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+        tile_init(&battery_objects[i].bar, battery_bar, battery_bar_repaint);
+#else
+        lv_obj_add_event_cb(battery_bar, battery_bar_draw_cb, LV_EVENT_DRAW_MAIN, (void *)(uintptr_t)i);
+#endif
 
-        lv_obj_add_flag(image_canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_align(battery_bar, LV_ALIGN_BOTTOM_MID, BATTERY_SLOT_X(i),
+                     -8 - (BATTERY_ROWS - 1 - BATTERY_SLOT_ROW(i)) * BATTERY_ROW_HEIGHT);
+        lv_obj_add_flag(battery_bar, LV_OBJ_FLAG_HIDDEN);
         lv_obj_add_flag(battery_label, LV_OBJ_FLAG_HIDDEN);
-        
-        battery_objects[i] = (struct battery_object){
-            .symbol = image_canvas,
-            .label = battery_label,
-        };
+
+        battery_objects[i].symbol = battery_bar;
+
+#if BATTERY_LABEL_TREND
+        lv_obj_t *trend = lv_label_create(widget->obj);
+        lv_label_set_text_static(trend, "");
+        lv_obj_set_width(trend, battery_trend_width);
+        lv_obj_add_style(trend, battery_level_style(BATTERY_LEVEL_NORMAL), 0);
+        lv_obj_add_flag(trend, LV_OBJ_FLAG_HIDDEN);
+        battery_objects[i].trend = trend;
+        battery_label_align(i, false);
+#else
+        lv_obj_align(battery_label, LV_ALIGN_TOP_MID, BATTERY_SLOT_X(i),
+                     BATTERY_SLOT_ROW(i) * BATTERY_ROW_HEIGHT);
+#endif
     }
 
     sys_slist_append(&widgets, &widget->node);
 
-    // Initialize peripheral tracking
-    init_peripheral_tracking();
+    // Levels are tracked while no widget exists as well, a rebuilt widget shows them right away
+    for (int i = 0; i < BATTERY_SOURCE_COUNT; i++) {
+        if (last_battery_levels[i] >= 0) {
+            show_battery_level(i, -1, last_battery_levels[i]);
+        }
+    }
 
     widget_dongle_battery_status_init();
 
     return 0;
 }
 
+void zmk_widget_dongle_battery_status_deinit(struct zmk_widget_dongle_battery_status *widget) {
+    sys_slist_find_and_remove(&widgets, &widget->node);
+    if (widget->obj != NULL) {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
 lv_obj_t *zmk_widget_dongle_battery_status_obj(struct zmk_widget_dongle_battery_status *widget) {
     return widget->obj;
-}
\ No newline at end of file
+}
+
+DONGLE_SCREEN_WIDGET_DEFINE(battery_status, 20, struct zmk_widget_dongle_battery_status,
+                            zmk_widget_dongle_battery_status_init,
+                            zmk_widget_dongle_battery_status_deinit, SCREEN_LAYOUT_BATTERY);
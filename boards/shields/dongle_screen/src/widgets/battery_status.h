@@ -8,6 +8,23 @@
 
 #include <lvgl.h>
 #include <zephyr/kernel.h>
+#include <zmk/split/central.h>
+
+#if IS_ENABLED(CONFIG_ZMK_DONGLE_DISPLAY_DONGLE_BATTERY)
+    #define SOURCE_OFFSET 1
+#else
+    #define SOURCE_OFFSET 0
+#endif
+
+#define BATTERY_SOURCE_COUNT (ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT + SOURCE_OFFSET)
+#define BATTERY_LEVEL_UNSEEN 0xFF
+
+// Up to BATTERY_MAX_COLUMNS sources share a row, more sources wrap into additional rows
+#define BATTERY_ROW_HEIGHT 40
+#define BATTERY_MAX_COLUMNS 4
+#define BATTERY_COLUMNS MIN(BATTERY_SOURCE_COUNT, BATTERY_MAX_COLUMNS)
+#define BATTERY_ROWS DIV_ROUND_UP(BATTERY_SOURCE_COUNT, BATTERY_COLUMNS)
+#define BATTERY_WIDGET_HEIGHT (BATTERY_ROWS * BATTERY_ROW_HEIGHT)
 
 struct zmk_widget_dongle_battery_status {
     sys_snode_t node;
@@ -15,4 +32,11 @@ struct zmk_widget_dongle_battery_status {
 };
 
 int zmk_widget_dongle_battery_status_init(struct zmk_widget_dongle_battery_status *widget, lv_obj_t *parent);
-lv_obj_t *zmk_widget_dongle_battery_status_obj(struct zmk_widget_dongle_battery_status *widget);
\ No newline at end of file
+void zmk_widget_dongle_battery_status_deinit(struct zmk_widget_dongle_battery_status *widget);
+lv_obj_t *zmk_widget_dongle_battery_status_obj(struct zmk_widget_dongle_battery_status *widget);
+
+/**
+ * @brief Latest reported level of a source, as shown by the widget
+ * @return Level in percent, BATTERY_LEVEL_UNSEEN if the source has not reported yet
+ */
+uint8_t battery_status_get_level(uint8_t source);
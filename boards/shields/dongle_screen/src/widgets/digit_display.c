@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "digit_display.h"
+#include "glyph_cache.h"
+#include "../screen_layout.h"
+#include "../profiler.h"
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+
+static void digit_display_draw_cell(struct digit_display *display, int cell)
+{
+    tile_draw_letter(&display->tile, cell * display->slot_width, display->slot_width, display->font,
+                     display->cells[cell], lv_obj_get_style_text_color(display->obj, LV_PART_MAIN));
+}
+
+static void digit_display_repaint(struct tile *tile)
+{
+    struct digit_display *display = CONTAINER_OF(tile, struct digit_display, tile);
+
+    for (int i = 0; i < display->slots; i++)
+    {
+        digit_display_draw_cell(display, i);
+    }
+}
+
+#else
+
+static void digit_display_draw_cb(lv_event_t *e)
+{
+    struct digit_display *display = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    dsc.font = display->font;
+
+    for (int i = 0; i < display->slots; i++)
+    {
+        char c = display->cells[i];
+        if (c == ' ')
+        {
+            continue;
+        }
+
+        lv_point_t pos = {
+            .x = coords.x1 + i * display->slot_width +
+                 (display->slot_width - lv_font_get_glyph_width(display->font, c, 0)) / 2,
+            .y = coords.y1,
+        };
+        lv_draw_letter(draw_ctx, &dsc, &pos, c);
+    }
+}
+
+static void digit_display_invalidate_cell(struct digit_display *display, int cell)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(display->obj, &coords);
+
+    lv_area_t area = {
+        .x1 = coords.x1 + cell * display->slot_width,
+        .y1 = coords.y1,
+        .x2 = coords.x1 + (cell + 1) * display->slot_width - 1,
+        .y2 = coords.y2,
+    };
+    lv_obj_invalidate_area(display->obj, &area);
+}
+
+#endif
+
+lv_obj_t *digit_display_create(struct digit_display *display, lv_obj_t *parent, const lv_font_t *font,
+                               uint8_t slots, enum digit_display_align align)
+{
+    if (font == NULL)
+    {
+        font = lv_obj_get_style_text_font(parent, LV_PART_MAIN);
+    }
+
+    display->font = glyph_cache_font(font);
+    display->slots = MIN(slots, DIGIT_DISPLAY_MAX_SLOTS);
+    display->align = align;
+    memset(display->cells, ' ', sizeof(display->cells));
+
+    // Digits of proportional fonts differ in width, the widest one defines the cell
+    display->slot_width = 0;
+    for (char c = '0'; c <= '9'; c++)
+    {
+        display->slot_width = MAX(display->slot_width, lv_font_get_glyph_width(font, c, 0));
+    }
+
+    display->obj = screen_layout_obj_create(parent);
+    lv_obj_set_size(display->obj, display->slots * display->slot_width, lv_font_get_line_height(font));
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+    tile_init(&display->tile, display->obj, digit_display_repaint);
+#else
+    lv_obj_add_event_cb(display->obj, digit_display_draw_cb, LV_EVENT_DRAW_MAIN, display);
+#endif
+
+    return display->obj;
+}
+
+void digit_display_fit(struct digit_display *display, const char *chars)
+{
+    for (const char *c = chars; *c != '\0'; c++)
+    {
+        display->slot_width = MAX(display->slot_width, lv_font_get_glyph_width(display->font, *c, 0));
+    }
+    lv_obj_set_width(display->obj, display->slots * display->slot_width);
+}
+
+void digit_display_set_text(struct digit_display *display, const char *text)
+{
+    char cells[DIGIT_DISPLAY_MAX_SLOTS];
+    size_t len = MIN(strlen(text), display->slots);
+    size_t offset = 0;
+
+    switch (display->align)
+    {
+    case DIGIT_DISPLAY_ALIGN_RIGHT:
+        offset = display->slots - len;
+        break;
+    case DIGIT_DISPLAY_ALIGN_CENTER:
+        offset = (display->slots - len) / 2;
+        break;
+    default:
+        break;
+    }
+
+    memset(cells, ' ', sizeof(cells));
+    memcpy(&cells[offset], text, len);
+
+    uint32_t start = k_cycle_get_32();
+    bool changed = false;
+
+    for (int i = 0; i < display->slots; i++)
+    {
+        if (cells[i] != display->cells[i])
+        {
+            display->cells[i] = cells[i];
+            changed = true;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+            // Until the tile is on the screen its repaint draws the cells
+            if (tile_shown(&display->tile))
+            {
+                digit_display_draw_cell(display, i);
+            }
+#else
+            digit_display_invalidate_cell(display, i);
+#endif
+        }
+    }
+
+    if (!changed)
+    {
+        return;
+    }
+
+    // Compares both renderers: the cells are on the panel after the write here, or after the next LVGL flush
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+    profiler_latency_record(PROFILER_LATENCY_DIGIT_UPDATE, start);
+#else
+    profiler_latency_begin(PROFILER_LATENCY_DIGIT_UPDATE, start);
+#endif
+}
+
+void digit_display_set_value(struct digit_display *display, int value)
+{
+    char text[12];
+
+    snprintf(text, sizeof(text), "%d", value);
+    digit_display_set_text(display, text);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+#include "tile_renderer.h"
+#endif
+
+#define DIGIT_DISPLAY_MAX_SLOTS 10
+
+enum digit_display_align
+{
+    DIGIT_DISPLAY_ALIGN_LEFT,
+    DIGIT_DISPLAY_ALIGN_RIGHT,
+    DIGIT_DISPLAY_ALIGN_CENTER,
+};
+
+/**
+ * @brief Short numeric text drawn in fixed-width character cells
+ *
+ * Unlike a label, changing the text does not re-measure anything and only the cells whose
+ * character changed are invalidated, e.g. only the last digit when 87 becomes 88.
+ * Glyphs are served from the glyph cache (CONFIG_DONGLE_SCREEN_GLYPH_CACHE_SIZE).
+ * With CONFIG_DONGLE_SCREEN_TILE_RENDERER the changed cells are written to the panel directly.
+ */
+struct digit_display
+{
+    lv_obj_t *obj;
+    const lv_font_t *font;
+    lv_coord_t slot_width;
+    uint8_t slots;
+    uint8_t align;
+    char cells[DIGIT_DISPLAY_MAX_SLOTS];
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_TILE_RENDERER)
+    struct tile tile;
+#endif
+};
+
+/**
+ * @brief Create the display object
+ * @param font Font to draw with, NULL for the font inherited from the parent
+ * @param slots Number of character cells, at most DIGIT_DISPLAY_MAX_SLOTS
+ */
+lv_obj_t *digit_display_create(struct digit_display *display, lv_obj_t *parent, const lv_font_t *font,
+                               uint8_t slots, enum digit_display_align align);
+
+/**
+ * @brief Widen the cells so every given character fits, cells only fit the digits by default
+ */
+void digit_display_fit(struct digit_display *display, const char *chars);
+
+/**
+ * @brief Show a text, truncated to the number of slots
+ */
+void digit_display_set_text(struct digit_display *display, const char *text);
+
+/**
+ * @brief Show a decimal number
+ */
+void digit_display_set_value(struct digit_display *display, int value);
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "glyph_cache.h"
+#include "../profiler.h"
+
+#if CONFIG_DONGLE_SCREEN_GLYPH_CACHE_SIZE > 0
+
+#define GLYPH_CACHE_FONTS 4
+#define GLYPH_CACHE_ENTRIES 48
+
+// A font wrapping the base font, glyph metrics still come from the base font description
+struct glyph_cache_font
+{
+    lv_font_t font; // Must be first, the callbacks get a pointer to it
+    const lv_font_t *base;
+};
+
+struct glyph_cache_entry
+{
+    const lv_font_t *base;
+    uint32_t letter;
+    uint32_t last_used;
+    uint8_t *bitmap; // 8 bit alpha, NULL while the entry is unused
+};
+
+K_HEAP_DEFINE(glyph_heap, CONFIG_DONGLE_SCREEN_GLYPH_CACHE_SIZE);
+
+static struct glyph_cache_font cache_fonts[GLYPH_CACHE_FONTS];
+static struct glyph_cache_entry entries[GLYPH_CACHE_ENTRIES];
+static uint32_t use_counter;
+
+// Glyphs larger than a quarter of the budget would evict everything else, they are drawn uncached
+static bool glyph_cacheable(const lv_font_glyph_dsc_t *dsc)
+{
+    size_t size = (size_t)dsc->box_w * dsc->box_h;
+
+    return size > 0 && size <= CONFIG_DONGLE_SCREEN_GLYPH_CACHE_SIZE / 4 && dsc->bpp < 8;
+}
+
+static void glyph_cache_evict(struct glyph_cache_entry *entry)
+{
+    k_heap_free(&glyph_heap, entry->bitmap);
+    entry->bitmap = NULL;
+}
+
+static struct glyph_cache_entry *least_recently_used(void)
+{
+    struct glyph_cache_entry *lru = NULL;
+
+    for (int i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        if (entries[i].bitmap != NULL && (lru == NULL || entries[i].last_used < lru->last_used))
+        {
+            lru = &entries[i];
+        }
+    }
+    return lru;
+}
+
+static uint8_t *glyph_alloc(size_t size)
+{
+    uint8_t *buf;
+
+    while ((buf = k_heap_alloc(&glyph_heap, size, K_NO_WAIT)) == NULL)
+    {
+        struct glyph_cache_entry *victim = least_recently_used();
+        if (victim == NULL)
+        {
+            return NULL;
+        }
+        glyph_cache_evict(victim);
+    }
+    return buf;
+}
+
+// Unpack a glyph bitmap to one alpha byte per pixel, rows are packed without padding
+static void glyph_unpack(uint8_t *dst, const uint8_t *src, const lv_font_glyph_dsc_t *dsc)
+{
+    // Compressed 3 bpp glyphs are decoded to 4 bpp
+    uint8_t bpp = dsc->bpp == 3 ? 4 : dsc->bpp;
+    uint8_t max = (1 << bpp) - 1;
+    uint32_t count = (uint32_t)dsc->box_w * dsc->box_h;
+
+    for (uint32_t i = 0, bit = 0; i < count; i++, bit += bpp)
+    {
+        uint8_t value = (src[bit >> 3] >> (8 - bpp - (bit & 7))) & max;
+        dst[i] = value * 255 / max;
+    }
+}
+
+static bool cached_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter,
+                                 uint32_t letter_next)
+{
+    const struct glyph_cache_font *cache = (const struct glyph_cache_font *)font;
+
+    if (!cache->base->get_glyph_dsc(cache->base, dsc, letter, letter_next))
+    {
+        return false;
+    }
+
+    // The bitmap callback serves all cacheable glyphs as 8 bit alpha
+    if (glyph_cacheable(dsc))
+    {
+        dsc->bpp = 8;
+    }
+    return true;
+}
+
+static const uint8_t *cached_get_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    const struct glyph_cache_font *cache = (const struct glyph_cache_font *)font;
+    const lv_font_t *base = cache->base;
+    struct glyph_cache_entry *free_entry = NULL;
+
+    use_counter++;
+
+    for (int i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+        struct glyph_cache_entry *entry = &entries[i];
+
+        if (entry->bitmap == NULL)
+        {
+            free_entry = free_entry ? free_entry : entry;
+        }
+        else if (entry->base == base && entry->letter == letter)
+        {
+            entry->last_used = use_counter;
+            profiler_count(PROFILER_GLYPH_CACHE_HITS);
+            return entry->bitmap;
+        }
+    }
+
+    profiler_count(PROFILER_GLYPH_CACHE_MISSES);
+
+    lv_font_glyph_dsc_t dsc;
+    const uint8_t *bitmap = base->get_glyph_bitmap(base, letter);
+
+    if (bitmap == NULL || !base->get_glyph_dsc(base, &dsc, letter, 0) || !glyph_cacheable(&dsc))
+    {
+        return bitmap;
+    }
+
+    if (free_entry == NULL)
+    {
+        free_entry = least_recently_used();
+        glyph_cache_evict(free_entry);
+    }
+
+    // The glyph was announced as 8 bpp, so it has to fit even if everything else is evicted
+    uint8_t *copy = glyph_alloc((size_t)dsc.box_w * dsc.box_h);
+    if (copy == NULL)
+    {
+        LOG_ERR("Glyph U+%04X does not fit into the glyph cache", letter);
+        return NULL;
+    }
+
+    glyph_unpack(copy, bitmap, &dsc);
+
+    free_entry->base = base;
+    free_entry->letter = letter;
+    free_entry->last_used = use_counter;
+    free_entry->bitmap = copy;
+    return copy;
+}
+
+const lv_font_t *glyph_cache_font(const lv_font_t *base)
+{
+    if (base == NULL)
+    {
+        return NULL;
+    }
+
+    for (int i = 0; i < GLYPH_CACHE_FONTS; i++)
+    {
+        struct glyph_cache_font *cache = &cache_fonts[i];
+
+        if (cache->base == base || &cache->font == base)
+        {
+            return &cache->font;
+        }
+
+        if (cache->base == NULL)
+        {
+            cache->base = base;
+            cache->font = *base;
+            cache->font.get_glyph_dsc = cached_get_glyph_dsc;
+            cache->font.get_glyph_bitmap = cached_get_glyph_bitmap;
+            return &cache->font;
+        }
+    }
+
+    LOG_WRN("No glyph cache slot left for another font");
+    return base;
+}
+
+#else
+
+const lv_font_t *glyph_cache_font(const lv_font_t *base) { return base; }
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/**
+ * @brief Get a font serving the glyphs of base from the glyph cache
+ *
+ * The returned font has the metrics and fallback of base, but its glyphs are unpacked once
+ * to 8 bit alpha masks and kept in an LRU cache of CONFIG_DONGLE_SCREEN_GLYPH_CACHE_SIZE bytes.
+ * Drawing a cached glyph again skips decoding (and decompressing) the font bitmap.
+ * Use it in place of base, e.g. as text_font style.
+ *
+ * @return The caching font, or base itself if the cache is disabled or out of font slots
+ */
+const lv_font_t *glyph_cache_font(const lv_font_t *base);
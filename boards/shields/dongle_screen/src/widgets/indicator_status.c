@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/hid_indicators_changed.h>
+#include <zmk/hid_indicators.h>
+
+#include "indicator_status.h"
+#include "widget_listener.h"
+#include "widget_registry.h"
+
+// Bits of the HID keyboard LED report
+#define INDICATOR_NUM_LOCK BIT(0)
+#define INDICATOR_CAPS_LOCK BIT(1)
+#define INDICATOR_SCROLL_LOCK BIT(2)
+
+static const struct
+{
+    uint8_t mask;
+    char letter;
+} indicator_cells[] = {
+    {INDICATOR_NUM_LOCK, 'N'},
+    {INDICATOR_CAPS_LOCK, 'C'},
+    {INDICATOR_SCROLL_LOCK, 'S'},
+};
+
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+struct indicator_status_state
+{
+    uint8_t indicators;
+} __packed; // compared with memcmp by the widget listener
+
+// Hosts re-send the LED report e.g. on every reconnect, the widget listener drops those unchanged
+// states before a frame is scheduled. Only the other bits of the report are masked out here.
+static struct indicator_status_state indicator_status_get_state(const zmk_event_t *eh)
+{
+    zmk_hid_indicators_t indicators = eh != NULL ? as_zmk_hid_indicators_changed(eh)->indicators
+                                                 : zmk_hid_indicators_get_current_profile();
+
+    return (struct indicator_status_state){
+        .indicators = indicators & (INDICATOR_NUM_LOCK | INDICATOR_CAPS_LOCK | INDICATOR_SCROLL_LOCK),
+    };
+}
+
+// Every indicator has its own cell, digit_display only invalidates the cells whose letter changed
+static void set_indicators(struct zmk_widget_indicator_status *widget, uint8_t indicators)
+{
+    char text[ARRAY_SIZE(indicator_cells) + 1] = {};
+
+    for (int i = 0; i < ARRAY_SIZE(indicator_cells); i++)
+    {
+        text[i] = indicators & indicator_cells[i].mask ? indicator_cells[i].letter : ' ';
+    }
+    digit_display_set_text(&widget->cells, text);
+}
+
+static void indicator_status_update_cb(struct indicator_status_state state)
+{
+    struct zmk_widget_indicator_status *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_indicators(widget, state.indicators); }
+}
+
+DONGLE_SCREEN_WIDGET_LISTENER(widget_indicator_status, struct indicator_status_state,
+                              indicator_status_update_cb, indicator_status_get_state)
+ZMK_SUBSCRIPTION(widget_indicator_status, zmk_hid_indicators_changed);
+
+int zmk_widget_indicator_status_init(struct zmk_widget_indicator_status *widget, lv_obj_t *parent)
+{
+    widget->obj = screen_layout_obj_create(parent);
+
+    lv_obj_t *cells = digit_display_create(&widget->cells, widget->obj, NULL, ARRAY_SIZE(indicator_cells),
+                                           DIGIT_DISPLAY_ALIGN_LEFT);
+    digit_display_fit(&widget->cells, "NCS");
+    lv_obj_align(cells, LV_ALIGN_CENTER, 0, 0);
+
+    sys_slist_append(&widgets, &widget->node);
+
+    widget_indicator_status_init();
+    return 0;
+}
+
+void zmk_widget_indicator_status_deinit(struct zmk_widget_indicator_status *widget)
+{
+    sys_slist_find_and_remove(&widgets, &widget->node);
+    if (widget->obj != NULL)
+    {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
+lv_obj_t *zmk_widget_indicator_status_obj(struct zmk_widget_indicator_status *widget)
+{
+    return widget->obj;
+}
+
+DONGLE_SCREEN_WIDGET_DEFINE(indicator_status, 60, struct zmk_widget_indicator_status,
+                            zmk_widget_indicator_status_init, zmk_widget_indicator_status_deinit,
+                            SCREEN_LAYOUT_INDICATOR);
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "digit_display.h"
+
+struct zmk_widget_indicator_status
+{
+    sys_snode_t node;
+    lv_obj_t *obj;
+    struct digit_display cells; // Num, Caps and Scroll lock, one cell each
+};
+
+int zmk_widget_indicator_status_init(struct zmk_widget_indicator_status *widget, lv_obj_t *parent);
+void zmk_widget_indicator_status_deinit(struct zmk_widget_indicator_status *widget);
+lv_obj_t *zmk_widget_indicator_status_obj(struct zmk_widget_indicator_status *widget);
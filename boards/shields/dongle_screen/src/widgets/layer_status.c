@@ -4,77 +4,188 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include <zmk/display.h>
-#include <zmk/display/widgets/layer_status.h>
 #include <zmk/events/layer_state_changed.h>
 #include <zmk/event_manager.h>
 #include <zmk/endpoints.h>
 #include <zmk/keymap.h>
 
+#include "layer_status.h"
+#include "widget_listener.h"
+#include "glyph_cache.h"
+#include "text_sprite.h"
+#include "../profiler.h"
+#include "widget_registry.h"
+
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
+// Cycle count of the latest layer event, for the event-to-glass latency. Taken by the next update,
+// 0 when the update has no event behind it (initial state, rebuilt widget).
+static atomic_t layer_event_cycles;
+
+// Layer names are shown with up to this many characters
+#define LAYER_NAME_MAX_LEN 12
+
 struct layer_status_state
 {
     uint8_t index;
-    const char *label;
-};
+    // A copy of the name, so a layer renamed at runtime compares as a change. Zero padded for
+    // memcmp, empty for layers without a name.
+    char label[LAYER_NAME_MAX_LEN + 1];
+} __packed; // compared with memcmp by the widget listener
+
+// widget->obj is a container holding the name label, the index digits and the layer name sprite,
+// only one of them is shown
+#define LAYER_CHILD_LABEL 0
+#define LAYER_CHILD_SPRITE 2
 
-static void set_layer_symbol(lv_obj_t *label, struct layer_status_state state)
+static void show_layer_child(lv_obj_t *obj, lv_obj_t *shown)
 {
-    if (state.label == NULL)
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++)
     {
-        char text[7] = {};
+        lv_obj_t *child = lv_obj_get_child(obj, i);
+
+        if (child == shown)
+        {
+            lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+        else
+        {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
 
-        sprintf(text, "%i", state.index);
+static void set_layer_symbol(struct zmk_widget_layer_status *widget, struct layer_status_state state)
+{
+    lv_obj_t *obj = widget->obj;
+    lv_obj_t *label = lv_obj_get_child(obj, LAYER_CHILD_LABEL);
 
-        lv_label_set_text(label, text);
-    }
-    else
+    if (state.label[0] == '\0')
     {
-        char text[13] = {};
-
-        snprintf(text, sizeof(text), "%s", state.label);
+        digit_display_set_value(&widget->digits, state.index);
+        show_layer_child(obj, widget->digits.obj);
+        return;
+    }
 
-        lv_label_set_text(label, text);
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_SPRITES)
+    // The name is rasterised once, switching back to a layer is a blit of its alpha mask
+    lv_obj_t *sprite = lv_obj_get_child(obj, LAYER_CHILD_SPRITE);
+    const lv_img_dsc_t *img = text_sprite_get(state.label, lv_obj_get_style_text_font(label, LV_PART_MAIN),
+                                              lv_obj_get_style_text_letter_space(label, LV_PART_MAIN));
+    if (img != NULL)
+    {
+        lv_img_set_src(sprite, img);
+        show_layer_child(obj, sprite);
+        return;
     }
+#endif
+
+    lv_label_set_text(label, state.label);
+    show_layer_child(obj, label);
 }
 
 static void layer_status_update_cb(struct layer_status_state state)
 {
     struct zmk_widget_layer_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_layer_symbol(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_layer_symbol(widget, state); }
+
+    uint32_t event_cycles = (uint32_t)atomic_clear(&layer_event_cycles);
+    if (event_cycles != 0)
+    {
+        profiler_latency_begin(PROFILER_LATENCY_LAYER_SWITCH, event_cycles);
+    }
 }
 
 static struct layer_status_state layer_status_get_state(const zmk_event_t *eh)
 {
-    uint8_t index = zmk_keymap_highest_layer_active();
-    return (struct layer_status_state){
-        .index = index,
-        .label = zmk_keymap_layer_name(index)};
+    struct layer_status_state state = {.index = zmk_keymap_highest_layer_active()};
+    const char *name = zmk_keymap_layer_name(state.index);
+
+    if (eh != NULL)
+    {
+        uint32_t cycles = k_cycle_get_32();
+
+        // 0 is reserved for "no event"
+        atomic_set(&layer_event_cycles, cycles != 0 ? cycles : 1);
+    }
+    if (name != NULL)
+    {
+        strncpy(state.label, name, LAYER_NAME_MAX_LEN);
+    }
+    return state;
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_layer_status, struct layer_status_state, layer_status_update_cb,
+DONGLE_SCREEN_WIDGET_LISTENER(widget_layer_status, struct layer_status_state, layer_status_update_cb,
                             layer_status_get_state)
 
 ZMK_SUBSCRIPTION(widget_layer_status, zmk_layer_state_changed);
 
+// All children are centered by one shared const style instead of local align properties
+static const lv_style_const_prop_t layer_child_props[] = {
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(layer_child_style, layer_child_props);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_SPRITES)
+// The sprite is an alpha mask, drawn in the text color of the screen
+static const lv_style_const_prop_t layer_sprite_props[] = {
+    LV_STYLE_CONST_IMG_RECOLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_CONST_IMG_RECOLOR_OPA(LV_OPA_COVER),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(layer_sprite_style, layer_sprite_props);
+#endif
+
 int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_label_create(parent);
+    widget->obj = screen_layout_obj_create(parent);
+    lv_obj_set_style_text_font(widget->obj, glyph_cache_font(&lv_font_montserrat_40), 0);
+
+    lv_obj_t *label = lv_label_create(widget->obj);
+    lv_obj_add_style(label, (lv_style_t *)&layer_child_style, 0);
 
-    lv_obj_set_style_text_font(widget->obj, &lv_font_montserrat_40, 0);
+    // Layers without a name show their index, which only redraws the changed digit
+    lv_obj_t *digits = digit_display_create(&widget->digits, widget->obj, NULL, 3, DIGIT_DISPLAY_ALIGN_CENTER);
+    lv_obj_add_style(digits, (lv_style_t *)&layer_child_style, 0);
+    lv_obj_add_flag(digits, LV_OBJ_FLAG_HIDDEN);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LAYER_SPRITES)
+    lv_obj_t *sprite = lv_img_create(widget->obj);
+    lv_obj_add_style(sprite, (lv_style_t *)&layer_child_style, 0);
+    lv_obj_add_style(sprite, (lv_style_t *)&layer_sprite_style, 0);
+    lv_obj_add_flag(sprite, LV_OBJ_FLAG_HIDDEN);
+#endif
 
     sys_slist_append(&widgets, &widget->node);
 
+    // An event whose state was dropped as unchanged left its timestamp behind, the rebuild is no switch
+    atomic_clear(&layer_event_cycles);
     widget_layer_status_init();
     return 0;
 }
 
+void zmk_widget_layer_status_deinit(struct zmk_widget_layer_status *widget)
+{
+    sys_slist_find_and_remove(&widgets, &widget->node);
+    if (widget->obj != NULL)
+    {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
 lv_obj_t *zmk_widget_layer_status_obj(struct zmk_widget_layer_status *widget)
 {
     return widget->obj;
-}
\ No newline at end of file
+}
+
+DONGLE_SCREEN_WIDGET_DEFINE(layer_status, 40, struct zmk_widget_layer_status,
+                            zmk_widget_layer_status_init, zmk_widget_layer_status_deinit,
+                            SCREEN_LAYOUT_LAYER);
@@ -1,18 +1,22 @@
-/*
- * Copyright (c) 2020 The ZMK Contributors
- *
- * SPDX-License-Identifier: MIT
- */
-
-#pragma once
-
-#include <lvgl.h>
-#include <zephyr/kernel.h>
-
-struct zmk_widget_layer_status {
-    sys_snode_t node;
-    lv_obj_t *obj;
-};
-
-int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_t *parent);
+/*
+ * Copyright (c) 2020 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "digit_display.h"
+
+struct zmk_widget_layer_status {
+    sys_snode_t node;
+    lv_obj_t *obj;
+    struct digit_display digits;
+};
+
+int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_t *parent);
+void zmk_widget_layer_status_deinit(struct zmk_widget_layer_status *widget);
 lv_obj_t *zmk_widget_layer_status_obj(struct zmk_widget_layer_status *widget);
\ No newline at end of file
@@ -4,12 +4,82 @@
 #include <lvgl.h>
 #include "mod_status.h"
 #include <fonts.h> // <-- Wichtig für LV_FONT_DECLARE
+#include "render_scheduler.h"
+#include "glyph_cache.h"
+#include "../profiler.h"
+#include "widget_registry.h"
 
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
-static void update_mod_status(struct zmk_widget_mod_status *widget)
+// Icons shown as generated images instead of font glyphs
+#define MOD_ICON_IMAGES                                                                            \
+    (IS_ENABLED(CONFIG_DONGLE_SCREEN_MOD_ICON_FORMAT_RGB565) ||                                     \
+     IS_ENABLED(CONFIG_DONGLE_SCREEN_MOD_ICON_FORMAT_RLE))
+
+static struct zmk_widget_mod_status *mod_widget;
+
+// Modifier state as last sampled by the timer and as last drawn by the render scheduler.
+// -1 forces the first draw.
+static atomic_t sampled_mods = ATOMIC_INIT(-1);
+static int16_t applied_mods = -1;
+
+#if MOD_ICON_IMAGES
+
+// Generated from the NerdFont by the build, pre-blended in white on black
+LV_IMG_DECLARE(mod_icon_ctrl);
+LV_IMG_DECLARE(mod_icon_shift);
+LV_IMG_DECLARE(mod_icon_alt);
+LV_IMG_DECLARE(mod_icon_gui);
+
+static const uint8_t mod_icon_masks[] = {
+    MOD_LCTL | MOD_RCTL,
+    MOD_LSFT | MOD_RSFT,
+    MOD_LALT | MOD_RALT,
+    MOD_LGUI | MOD_RGUI,
+};
+
+static const lv_img_dsc_t *const mod_icon_images[] = {
+    &mod_icon_ctrl,
+    &mod_icon_shift,
+    &mod_icon_alt,
+    &mod_icon_gui,
+};
+
+// The images are opaque RGB565 with the background already blended in, so LVGL copies
+// them line by line into the draw buffer (decoding the runs first for the RLE format). Shown icons are centered with the width of
+// a space between them, like the label text did.
+static void update_mod_status(struct zmk_widget_mod_status *widget, uint8_t mods)
+{
+    lv_coord_t gap = lv_font_get_glyph_width(&lv_font_montserrat_40, ' ', 0);
+    lv_coord_t width = -gap;
+
+    for (int i = 0; i < ARRAY_SIZE(widget->icons); i++)
+    {
+        if (mods & mod_icon_masks[i])
+        {
+            width += mod_icon_images[i]->header.w + gap;
+        }
+    }
+
+    lv_coord_t x = -width / 2;
+    for (int i = 0; i < ARRAY_SIZE(widget->icons); i++)
+    {
+        if (!(mods & mod_icon_masks[i]))
+        {
+            lv_obj_add_flag(widget->icons[i], LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+
+        lv_obj_align(widget->icons[i], LV_ALIGN_CENTER, x + mod_icon_images[i]->header.w / 2, 0);
+        lv_obj_clear_flag(widget->icons[i], LV_OBJ_FLAG_HIDDEN);
+        x += mod_icon_images[i]->header.w + gap;
+    }
+}
+
+#else
+
+static void update_mod_status(struct zmk_widget_mod_status *widget, uint8_t mods)
 {
-    uint8_t mods = zmk_hid_get_keyboard_report()->body.modifiers;
     char text[32] = "";
     int idx = 0;
 
@@ -43,32 +113,112 @@ static void update_mod_status(struct zmk_widget_mod_status *widget)
     lv_label_set_text(widget->label, idx ? text : "");
 }
 
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PROFILER)
+// Times the icons of every draw pass, to compare the icon formats
+static uint32_t draw_start_cycles;
+
+static void mod_status_draw_timing_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN_BEGIN)
+    {
+        draw_start_cycles = k_cycle_get_32();
+    }
+    else
+    {
+        profiler_timer_add(PROFILER_TIMER_MOD_ICONS_DRAW, k_cycle_get_32() - draw_start_cycles);
+    }
+}
+#endif
+
+static void mod_status_refresh(void)
+{
+    uint8_t mods = (uint8_t)atomic_get(&sampled_mods);
+
+    if (mod_widget == NULL || mods == applied_mods)
+    {
+        profiler_count(PROFILER_SUPPRESSED_UPDATES);
+        return;
+    }
+
+    applied_mods = mods;
+    profiler_count(PROFILER_WIDGET_RENDERS);
+    update_mod_status(mod_widget, mods);
+}
+
+static struct render_slot mod_status_slot = {.refresh = mod_status_refresh};
+
+// Runs in timer (ISR) context: only sample the modifiers and hand a redraw to the
+// render scheduler when they changed, instead of touching LVGL every tick.
 static void mod_status_timer_cb(struct k_timer *timer)
 {
-    struct zmk_widget_mod_status *widget = k_timer_user_data_get(timer);
-    update_mod_status(widget);
+    atomic_val_t mods = zmk_hid_get_keyboard_report()->body.modifiers;
+
+    if (atomic_set(&sampled_mods, mods) != mods)
+    {
+        render_scheduler_mark_dirty(&mod_status_slot);
+    }
 }
 
 static struct k_timer mod_status_timer;
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 180, 40);
+    widget->obj = screen_layout_obj_create(parent);
 
+#if MOD_ICON_IMAGES
+    for (int i = 0; i < ARRAY_SIZE(widget->icons); i++)
+    {
+        widget->icons[i] = lv_img_create(widget->obj);
+        lv_img_set_src(widget->icons[i], mod_icon_images[i]);
+        lv_obj_add_flag(widget->icons[i], LV_OBJ_FLAG_HIDDEN);
+    }
+#else
     widget->label = lv_label_create(widget->obj);
     lv_obj_align(widget->label, LV_ALIGN_CENTER, 0, 0);
     lv_label_set_text(widget->label, "-");
-    lv_obj_set_style_text_font(widget->label, &NerdFonts_Regular_40, 0); // <-- NerdFont setzen
+    lv_obj_set_style_text_font(widget->label, glyph_cache_font(&NerdFonts_Regular_40), 0); // <-- NerdFont setzen
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_PROFILER)
+    // Children are drawn between the main and the post phase of their parent
+    lv_obj_add_event_cb(widget->obj, mod_status_draw_timing_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    lv_obj_add_event_cb(widget->obj, mod_status_draw_timing_cb, LV_EVENT_DRAW_POST_END, NULL);
+#endif
+
+    mod_widget = widget;
+    applied_mods = -1;
+    render_scheduler_register(&mod_status_slot);
+
+    // A rebuilt widget shows the last sampled modifiers right away
+    if (atomic_get(&sampled_mods) >= 0)
+    {
+        mod_status_refresh();
+    }
 
     k_timer_init(&mod_status_timer, mod_status_timer_cb, NULL);
-    k_timer_user_data_set(&mod_status_timer, widget);
     k_timer_start(&mod_status_timer, K_MSEC(100), K_MSEC(100));
 
     return 0;
 }
 
+void zmk_widget_mod_status_deinit(struct zmk_widget_mod_status *widget)
+{
+    k_timer_stop(&mod_status_timer);
+    mod_widget = NULL;
+    if (widget->obj != NULL)
+    {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
 lv_obj_t *zmk_widget_mod_status_obj(struct zmk_widget_mod_status *widget)
 {
     return widget->obj;
 }
+
+DONGLE_SCREEN_WIDGET_DEFINE(mod_status, 50, struct zmk_widget_mod_status,
+                            zmk_widget_mod_status_init, zmk_widget_mod_status_deinit,
+                            SCREEN_LAYOUT_MODIFIER);
@@ -8,7 +8,9 @@ struct zmk_widget_mod_status
     sys_snode_t node;
     lv_obj_t *obj;
     lv_obj_t *label;
+    lv_obj_t *icons[4]; // Ctrl, Shift, Alt, GUI with the image icon formats
 };
 
 int zmk_widget_mod_status_init(struct zmk_widget_mod_status *widget, lv_obj_t *parent);
+void zmk_widget_mod_status_deinit(struct zmk_widget_mod_status *widget);
 lv_obj_t *zmk_widget_mod_status_obj(struct zmk_widget_mod_status *widget);
\ No newline at end of file
@@ -18,16 +18,23 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/ble.h>
 #include <zmk/endpoints.h>
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BLE_PROFILES)
+#include <zephyr/bluetooth/conn.h>
+#endif
+
 #include "output_status.h"
+#include "widget_listener.h"
+#include "widget_registry.h"
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
 lv_point_t selection_line_points[] = {{0, 0}, {13, 0}}; // will be replaced with lv_point_precise_t
 
+// Only single-byte members, so the state has no padding and can be compared with memcmp
 struct output_status_state
 {
-    struct zmk_endpoint_instance selected_endpoint;
-    int active_profile_index;
+    uint8_t transport;
+    uint8_t active_profile_index;
     bool active_profile_connected;
     bool active_profile_bonded;
     bool usb_is_hid_ready;
@@ -36,59 +43,134 @@ struct output_status_state
 static struct output_status_state get_state(const zmk_event_t *_eh)
 {
     return (struct output_status_state){
-        .selected_endpoint = zmk_endpoints_selected(),                     // 0 = USB , 1 = BLE
+        .transport = zmk_endpoints_selected().transport,                   // 0 = USB , 1 = BLE
         .active_profile_index = zmk_ble_active_profile_index(),            // 0-3 BLE profiles
         .active_profile_connected = zmk_ble_active_profile_is_connected(), // 0 = not connected, 1 = connected
         .active_profile_bonded = !zmk_ble_active_profile_is_open(),        // 0 =  BLE not bonded, 1 = bonded
         .usb_is_hid_ready = zmk_usb_is_hid_ready()};                       // 0 = not ready, 1 = ready
 }
 
-static void set_status_symbol(struct zmk_widget_output_status *widget, struct output_status_state state)
+enum link_color
+{
+    LINK_COLOR_IDLE,
+    LINK_COLOR_ERROR,
+    LINK_COLOR_BONDED,
+    LINK_COLOR_CONNECTED,
+};
+
+static lv_color_t link_color(enum link_color color)
 {
-    const char *ble_color = "ffffff";
-    const char *usb_color = "ffffff";
-    char transport_text[50] = {};
-    if (state.usb_is_hid_ready == 0)
+    switch (color)
     {
-        usb_color = "ff0000";
+    case LINK_COLOR_ERROR:
+        return lv_color_hex(0xff0000);
+    case LINK_COLOR_BONDED:
+        return lv_color_hex(0x0000ff);
+    case LINK_COLOR_CONNECTED:
+        return lv_color_hex(0x00ff00);
+    default:
+        return lv_color_hex(0xffffff);
     }
-    else
+}
+
+// Label colors as const styles in flash, same colors as link_color()
+static const lv_style_const_prop_t link_idle_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)),
+    LV_STYLE_PROP_INV,
+};
+static const lv_style_const_prop_t link_error_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xFF, 0x00, 0x00)),
+    LV_STYLE_PROP_INV,
+};
+static const lv_style_const_prop_t link_bonded_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0xFF)),
+    LV_STYLE_PROP_INV,
+};
+static const lv_style_const_prop_t link_connected_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0xFF, 0x00)),
+    LV_STYLE_PROP_INV,
+};
+static LV_STYLE_CONST_INIT(link_idle_style, link_idle_props);
+static LV_STYLE_CONST_INIT(link_error_style, link_error_props);
+static LV_STYLE_CONST_INIT(link_bonded_style, link_bonded_props);
+static LV_STYLE_CONST_INIT(link_connected_style, link_connected_props);
+
+static lv_style_t *link_style(enum link_color color)
+{
+    switch (color)
     {
-        usb_color = "ffffff";
+    case LINK_COLOR_ERROR:
+        return (lv_style_t *)&link_error_style;
+    case LINK_COLOR_BONDED:
+        return (lv_style_t *)&link_bonded_style;
+    case LINK_COLOR_CONNECTED:
+        return (lv_style_t *)&link_connected_style;
+    default:
+        return (lv_style_t *)&link_idle_style;
     }
+}
 
-    if (state.active_profile_connected == 1)
+// Swaps the color style of a label, no local style properties are allocated
+static void set_link_color(lv_obj_t *label, int8_t *shown, enum link_color color)
+{
+    if (*shown == color)
     {
-        ble_color = "00ff00";
+        return;
     }
-    else if (state.active_profile_bonded == 1)
+
+    if (*shown < 0)
     {
-        ble_color = "0000ff";
+        lv_obj_add_style(label, link_style(color), 0);
     }
     else
     {
-        ble_color = "ffffff";
+        lv_obj_replace_style(label, link_style(*shown), link_style(color), 0);
     }
+    *shown = color;
+}
+
+// Puts the marker left of the selected transport. Aligned to the widget with the same style offsets
+// as the transport labels instead of once to their current coordinates, which are not known before
+// the layout placed the widget.
+static void align_selection_label(struct zmk_widget_output_status *widget, lv_obj_t *selected)
+{
+    lv_point_t size;
+
+    lv_txt_get_size(&size, lv_label_get_text(selected), lv_obj_get_style_text_font(selected, LV_PART_MAIN),
+                    lv_obj_get_style_text_letter_space(selected, LV_PART_MAIN), 0, LV_COORD_MAX,
+                    LV_TEXT_FLAG_NONE);
+    lv_obj_align(widget->selection_label, LV_ALIGN_TOP_RIGHT, lv_obj_get_style_x(selected, LV_PART_MAIN) - size.x,
+                 lv_obj_get_style_y(selected, LV_PART_MAIN));
+}
+
+// The labels are created once with static text, an update only moves the selection marker,
+// recolors a transport or changes the profile digit when that part of the state changed
+static void set_status_symbol(struct zmk_widget_output_status *widget, struct output_status_state state)
+{
+    set_link_color(widget->usb_label, &widget->shown_usb_color,
+                   state.usb_is_hid_ready ? LINK_COLOR_IDLE : LINK_COLOR_ERROR);
 
-    switch (state.selected_endpoint.transport)
+    enum link_color ble_color = LINK_COLOR_IDLE;
+    if (state.active_profile_connected)
     {
-    case ZMK_TRANSPORT_USB:
-        snprintf(transport_text, sizeof(transport_text), "> #%s USB#\n#%s BLE#", usb_color, ble_color);
-        break;
-    case ZMK_TRANSPORT_BLE:
-        snprintf(transport_text, sizeof(transport_text), "#%s USB#\n> #%s BLE#", usb_color, ble_color);
-        break;
+        ble_color = LINK_COLOR_CONNECTED;
     }
+    else if (state.active_profile_bonded)
+    {
+        ble_color = LINK_COLOR_BONDED;
+    }
+    set_link_color(widget->ble_label, &widget->shown_ble_color, ble_color);
 
-    lv_label_set_recolor(widget->transport_label, true);
-    lv_obj_set_style_text_align(widget->transport_label, LV_TEXT_ALIGN_RIGHT, 0);
-    lv_label_set_text(widget->transport_label, transport_text);
-
-    char ble_text[12];
+    if (widget->shown_transport != state.transport)
+    {
+        widget->shown_transport = state.transport;
+        lv_obj_t *selected = state.transport == ZMK_TRANSPORT_USB ? widget->usb_label : widget->ble_label;
+        align_selection_label(widget, selected);
+    }
 
-    snprintf(ble_text, sizeof(ble_text), "%d", state.active_profile_index + 1);
-    // lv_obj_set_style_text_align(widget->ble_label, LV_TEXT_ALIGN_RIGHT, 0);
-    lv_label_set_text(widget->ble_label, ble_text);
+#if !IS_ENABLED(CONFIG_DONGLE_SCREEN_BLE_PROFILES)
+    digit_display_set_value(&widget->profile_digits, state.active_profile_index + 1);
+#endif
 }
 
 static void output_status_update_cb(struct output_status_state state)
@@ -100,31 +182,238 @@ static void output_status_update_cb(struct output_status_state state)
     }
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_output_status, struct output_status_state,
+DONGLE_SCREEN_WIDGET_LISTENER(widget_output_status, struct output_status_state,
                             output_status_update_cb, get_state)
 ZMK_SUBSCRIPTION(widget_output_status, zmk_endpoint_changed);
 ZMK_SUBSCRIPTION(widget_output_status, zmk_ble_active_profile_changed);
 ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BLE_PROFILES)
+
+#define PROFILE_COUNT (ZMK_BLE_PROFILE_COUNT)
+#define PROFILE_CELL_WIDTH 16
+#define PROFILE_CELL_GAP 2
+#define PROFILE_CELL_HEIGHT 22
+
+BUILD_ASSERT(PROFILE_COUNT <= 16, "The profile overview keeps the profiles in 16 bit masks");
+
+struct ble_profiles_state
+{
+    uint16_t bonded;
+    uint16_t connected;
+    uint8_t active;
+} __packed; // compared with memcmp by the widget listener
+
+// Only called for profile and connection events, the endpoint events of the output status
+// do not touch the overview
+static struct ble_profiles_state ble_profiles_get_state(const zmk_event_t *eh)
+{
+    struct ble_profiles_state state = {.active = zmk_ble_active_profile_index()};
+
+    for (int i = 0; i < PROFILE_COUNT; i++)
+    {
+        if (!zmk_ble_profile_is_open(i))
+        {
+            state.bonded |= BIT(i);
+        }
+        if (zmk_ble_profile_is_connected(i))
+        {
+            state.connected |= BIT(i);
+        }
+    }
+    return state;
+}
+
+static void profile_cell_area(lv_obj_t *obj, int index, lv_area_t *cell)
+{
+    lv_obj_get_coords(obj, cell);
+    cell->x1 += index * (PROFILE_CELL_WIDTH + PROFILE_CELL_GAP);
+    cell->x2 = cell->x1 + PROFILE_CELL_WIDTH - 1;
+}
+
+static void ble_profiles_draw_cb(lv_event_t *e)
+{
+    struct zmk_widget_output_status *widget = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    for (int i = 0; i < PROFILE_COUNT; i++)
+    {
+        bool active = widget->shown_active == i;
+        enum link_color color = LINK_COLOR_IDLE;
+
+        if (widget->shown_connected & BIT(i))
+        {
+            color = LINK_COLOR_CONNECTED;
+        }
+        else if (widget->shown_bonded & BIT(i))
+        {
+            color = LINK_COLOR_BONDED;
+        }
+
+        lv_area_t cell;
+        profile_cell_area(obj, i, &cell);
+
+        // The active profile is a filled cell, the others only get a frame
+        lv_draw_rect_dsc_t rect_dsc;
+        lv_draw_rect_dsc_init(&rect_dsc);
+        rect_dsc.radius = 2;
+        rect_dsc.border_width = 1;
+        rect_dsc.border_color = link_color(color);
+        rect_dsc.bg_opa = active ? LV_OPA_COVER : LV_OPA_TRANSP;
+        rect_dsc.bg_color = link_color(color);
+        lv_draw_rect(draw_ctx, &rect_dsc, &cell);
+
+        if (i >= 9)
+        {
+            continue; // No room for two digits, the cell alone marks the profile
+        }
+
+        char digit = '1' + i;
+
+        label_dsc.color = active ? lv_color_black() : link_color(color);
+        lv_point_t pos = {
+            .x = cell.x1 + (PROFILE_CELL_WIDTH - lv_font_get_glyph_width(label_dsc.font, digit, 0)) / 2,
+            .y = cell.y1 + (PROFILE_CELL_HEIGHT - lv_font_get_line_height(label_dsc.font)) / 2,
+        };
+        lv_draw_letter(draw_ctx, &label_dsc, &pos, digit);
+    }
+}
+
+static void ble_profiles_update_cb(struct ble_profiles_state state)
+{
+    struct zmk_widget_output_status *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
+    {
+        uint16_t changed = (state.bonded ^ widget->shown_bonded) | (state.connected ^ widget->shown_connected);
+
+        if (state.active != widget->shown_active)
+        {
+            changed |= BIT(state.active);
+            if (widget->shown_active < PROFILE_COUNT)
+            {
+                changed |= BIT(widget->shown_active);
+            }
+        }
+
+        widget->shown_bonded = state.bonded;
+        widget->shown_connected = state.connected;
+        widget->shown_active = state.active;
+
+        // Only the cells of profiles whose state changed are redrawn
+        for (int i = 0; i < PROFILE_COUNT; i++)
+        {
+            if (changed & BIT(i))
+            {
+                lv_area_t cell;
+                profile_cell_area(widget->profiles, i, &cell);
+                lv_obj_invalidate_area(widget->profiles, &cell);
+            }
+        }
+    }
+}
+
+DONGLE_SCREEN_WIDGET_LISTENER(widget_ble_profiles, struct ble_profiles_state, ble_profiles_update_cb,
+                              ble_profiles_get_state)
+ZMK_SUBSCRIPTION(widget_ble_profiles, zmk_ble_active_profile_changed);
+
+// ZMK only raises an event for connection changes of the active profile
+static void ble_profiles_connection_changed(struct bt_conn *conn)
+{
+    struct bt_conn_info info;
+
+    if (bt_conn_get_info(conn, &info) == 0 && info.role == BT_CONN_ROLE_PERIPHERAL)
+    {
+        widget_ble_profiles_cb(NULL);
+    }
+}
+
+static void ble_profiles_connected(struct bt_conn *conn, uint8_t err)
+{
+    if (err == 0)
+    {
+        ble_profiles_connection_changed(conn);
+    }
+}
+
+static void ble_profiles_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+    ble_profiles_connection_changed(conn);
+}
+
+BT_CONN_CB_DEFINE(ble_profiles_conn_callbacks) = {
+    .connected = ble_profiles_connected,
+    .disconnected = ble_profiles_disconnected,
+};
+
+#endif // CONFIG_DONGLE_SCREEN_BLE_PROFILES
+
 // output_status.c
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 77);
+    widget->obj = screen_layout_obj_create(parent);
+
+    // Same layout as the former two line, right aligned label
+    lv_coord_t row_height = lv_font_get_line_height(lv_obj_get_style_text_font(widget->obj, LV_PART_MAIN)) +
+                            lv_obj_get_style_text_line_space(widget->obj, LV_PART_MAIN);
 
-    widget->transport_label = lv_label_create(widget->obj);
-    lv_obj_align(widget->transport_label, LV_ALIGN_TOP_RIGHT, -10, 10);
+    widget->usb_label = lv_label_create(widget->obj);
+    lv_label_set_text_static(widget->usb_label, "USB");
+    lv_obj_align(widget->usb_label, LV_ALIGN_TOP_RIGHT, -10, 10);
 
     widget->ble_label = lv_label_create(widget->obj);
-    lv_obj_align(widget->ble_label, LV_ALIGN_TOP_RIGHT, -10, 56);
+    lv_label_set_text_static(widget->ble_label, "BLE");
+    lv_obj_align(widget->ble_label, LV_ALIGN_TOP_RIGHT, -10, 10 + row_height);
+
+    widget->selection_label = lv_label_create(widget->obj);
+    lv_label_set_text_static(widget->selection_label, "> ");
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BLE_PROFILES)
+    widget->profiles = screen_layout_obj_create(widget->obj);
+    lv_obj_set_size(widget->profiles,
+                    PROFILE_COUNT * (PROFILE_CELL_WIDTH + PROFILE_CELL_GAP) - PROFILE_CELL_GAP,
+                    PROFILE_CELL_HEIGHT);
+    lv_obj_align(widget->profiles, LV_ALIGN_TOP_RIGHT, -10, 56);
+    lv_obj_add_event_cb(widget->profiles, ble_profiles_draw_cb, LV_EVENT_DRAW_MAIN, widget);
+    widget->shown_active = UINT8_MAX;
+#else
+    lv_obj_t *profile = digit_display_create(&widget->profile_digits, widget->obj, NULL, 2,
+                                             DIGIT_DISPLAY_ALIGN_RIGHT);
+    lv_obj_align(profile, LV_ALIGN_TOP_RIGHT, -10, 56);
+#endif
+
+    widget->shown_transport = -1;
+    widget->shown_usb_color = -1;
+    widget->shown_ble_color = -1;
 
     sys_slist_append(&widgets, &widget->node);
 
     widget_output_status_init();
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BLE_PROFILES)
+    widget_ble_profiles_init();
+#endif
     return 0;
 }
 
+void zmk_widget_output_status_deinit(struct zmk_widget_output_status *widget)
+{
+    sys_slist_find_and_remove(&widgets, &widget->node);
+    if (widget->obj != NULL)
+    {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
 lv_obj_t *zmk_widget_output_status_obj(struct zmk_widget_output_status *widget)
 {
     return widget->obj;
 }
+
+DONGLE_SCREEN_WIDGET_DEFINE(output_status, 10, struct zmk_widget_output_status,
+                            zmk_widget_output_status_init,
+                            zmk_widget_output_status_deinit, SCREEN_LAYOUT_OUTPUT);
@@ -9,14 +9,28 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "digit_display.h"
+
 // output_status.h
 struct zmk_widget_output_status
 {
     lv_obj_t *obj;
-    lv_obj_t *transport_label;
+    lv_obj_t *selection_label; // "> " in front of the selected transport
+    lv_obj_t *usb_label;
     lv_obj_t *ble_label;
+    struct digit_display profile_digits;
+    lv_obj_t *profiles;
+    // What is currently shown, so an update only touches the parts that changed
+    int8_t shown_transport;
+    int8_t shown_usb_color;
+    int8_t shown_ble_color;
+    // Profile overview as drawn: bit i of each mask is profile i, active is 0xFF before the first draw
+    uint16_t shown_bonded;
+    uint16_t shown_connected;
+    uint8_t shown_active;
     sys_snode_t node;
 };
 
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent);
+void zmk_widget_output_status_deinit(struct zmk_widget_output_status *widget);
 lv_obj_t *zmk_widget_output_status_obj(struct zmk_widget_output_status *widget);
\ No newline at end of file
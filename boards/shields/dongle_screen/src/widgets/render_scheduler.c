@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "render_scheduler.h"
+#include "../profiler.h"
+
+static sys_slist_t slots = SYS_SLIST_STATIC_INIT(&slots);
+
+static void render_frame(struct k_work *work)
+{
+    struct render_slot *slot;
+
+    profiler_count(PROFILER_FRAMES);
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&slots, slot, node)
+    {
+        if (atomic_cas(&slot->dirty, 1, 0))
+        {
+            slot->refresh();
+        }
+    }
+}
+
+K_WORK_DELAYABLE_DEFINE(render_frame_work, render_frame);
+
+void render_scheduler_register(struct render_slot *slot)
+{
+    // A rebuilt widget registers again, it moves to the end so the refresh order stays the creation order
+    sys_slist_find_and_remove(&slots, &slot->node);
+    sys_slist_append(&slots, &slot->node);
+}
+
+void render_scheduler_mark_dirty(struct render_slot *slot)
+{
+    if (!atomic_cas(&slot->dirty, 0, 1))
+    {
+        // Already waiting for the next frame, the newer state simply replaces the older one
+        profiler_count(PROFILER_COALESCED_EVENTS);
+        return;
+    }
+
+    // No-op if a frame is already scheduled, so the first event of a burst opens the frame slot
+    k_work_schedule_for_queue(zmk_display_work_q(), &render_frame_work,
+                              K_MSEC(CONFIG_DONGLE_SCREEN_RENDER_COALESCE_MS));
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief A widget taking part in coalesced rendering
+ *
+ * The widget keeps its latest state in its own mailbox and marks the slot dirty.
+ * All dirty slots are refreshed once in the next frame slot, so a burst of events
+ * for the same widget costs a single update.
+ */
+struct render_slot
+{
+    sys_snode_t node;
+    void (*refresh)(void);
+    atomic_t dirty;
+};
+
+/**
+ * @brief Register a slot with the scheduler, called from the widget init
+ *
+ * Registering a slot again moves it to the end of the refresh order.
+ */
+void render_scheduler_register(struct render_slot *slot);
+
+/**
+ * @brief Mark a slot dirty and make sure a frame is scheduled, safe from any context
+ */
+void render_scheduler_mark_dirty(struct render_slot *slot);
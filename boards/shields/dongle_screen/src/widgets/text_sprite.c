@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "text_sprite.h"
+
+#define TEXT_SPRITE_ENTRIES 8
+
+struct text_sprite
+{
+    const char *text; // Copy stored behind the pixel data, layer names can change at runtime
+    const lv_font_t *font;
+    lv_coord_t letter_space;
+    uint32_t last_used;
+    lv_img_dsc_t img; // img.data is NULL while the entry is unused
+};
+
+// Separate heap, so the sprites can never starve LVGL's own memory pool
+K_HEAP_DEFINE(sprite_heap, CONFIG_DONGLE_SCREEN_LAYER_SPRITE_CACHE_SIZE);
+
+static struct text_sprite sprites[TEXT_SPRITE_ENTRIES];
+static uint32_t use_counter;
+
+static void text_sprite_evict(struct text_sprite *sprite)
+{
+    LOG_DBG("Evicting sprite \"%s\"", sprite->text);
+
+    // LVGL's image cache still knows the old pixel data under this descriptor
+    lv_img_cache_invalidate_src(&sprite->img);
+    k_heap_free(&sprite_heap, (void *)sprite->img.data);
+    sprite->img.data = NULL;
+}
+
+static struct text_sprite *least_recently_used(void)
+{
+    struct text_sprite *lru = NULL;
+
+    for (int i = 0; i < TEXT_SPRITE_ENTRIES; i++)
+    {
+        if (sprites[i].img.data != NULL && (lru == NULL || sprites[i].last_used < lru->last_used))
+        {
+            lru = &sprites[i];
+        }
+    }
+    return lru;
+}
+
+static uint8_t *sprite_alloc(size_t size)
+{
+    uint8_t *buf;
+
+    while ((buf = k_heap_alloc(&sprite_heap, size, K_NO_WAIT)) == NULL)
+    {
+        struct text_sprite *victim = least_recently_used();
+        if (victim == NULL)
+        {
+            return NULL;
+        }
+        text_sprite_evict(victim);
+    }
+    return buf;
+}
+
+static void blend_glyph(uint8_t *buf, lv_coord_t w, lv_coord_t h, lv_coord_t x, lv_coord_t y,
+                        const lv_font_glyph_dsc_t *g, const uint8_t *bitmap)
+{
+    // Compressed 3 bpp glyphs are decoded to 4 bpp, rows are packed without padding
+    uint8_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    uint8_t max = (1 << bpp) - 1;
+    uint32_t bit = 0;
+
+    for (lv_coord_t row = 0; row < g->box_h; row++)
+    {
+        for (lv_coord_t col = 0; col < g->box_w; col++, bit += bpp)
+        {
+            lv_coord_t px = x + col;
+            lv_coord_t py = y + row;
+            if (px < 0 || px >= w || py < 0 || py >= h)
+            {
+                continue;
+            }
+
+            uint8_t value = (bitmap[bit >> 3] >> (8 - bpp - (bit & 7))) & max;
+            uint8_t *dst = &buf[py * w + px];
+
+            // Overlapping glyphs keep the stronger coverage
+            *dst = MAX(*dst, value * 255 / max);
+        }
+    }
+}
+
+static bool text_sprite_render(struct text_sprite *sprite, const char *text)
+{
+    const lv_font_t *font = sprite->font;
+    size_t text_len = strlen(text);
+    lv_coord_t w = lv_txt_get_width(text, text_len, font, sprite->letter_space, LV_TEXT_FLAG_NONE);
+    lv_coord_t h = lv_font_get_line_height(font);
+
+    if (w <= 0 || h <= 0)
+    {
+        return false;
+    }
+
+    uint8_t *buf = sprite_alloc((size_t)w * h + text_len + 1);
+    if (buf == NULL)
+    {
+        LOG_WRN("Sprite \"%s\" (%dx%d) does not fit into the cache", text, w, h);
+        return false;
+    }
+    memset(buf, 0, (size_t)w * h);
+    sprite->text = memcpy(&buf[(size_t)w * h], text, text_len + 1);
+
+    uint32_t i = 0;
+    lv_coord_t x = 0;
+    uint32_t letter = _lv_txt_encoded_next(text, &i);
+
+    while (letter != 0)
+    {
+        uint32_t next = _lv_txt_encoded_next(text, &i);
+        lv_font_glyph_dsc_t g;
+
+        if (lv_font_get_glyph_dsc(font, &g, letter, next))
+        {
+            const uint8_t *bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+
+            if (bitmap != NULL && g.box_w > 0 && g.box_h > 0)
+            {
+                // Same baseline placement as lv_draw_letter
+                lv_coord_t y = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+                blend_glyph(buf, w, h, x + g.ofs_x, y, &g, bitmap);
+            }
+            x += g.adv_w + sprite->letter_space;
+        }
+        letter = next;
+    }
+
+    sprite->img = (lv_img_dsc_t){
+        .header.cf = LV_IMG_CF_ALPHA_8BIT,
+        .header.w = w,
+        .header.h = h,
+        .data_size = (uint32_t)w * h,
+        .data = buf,
+    };
+
+    LOG_DBG("Rendered sprite \"%s\" (%dx%d)", text, w, h);
+    return true;
+}
+
+const lv_img_dsc_t *text_sprite_get(const char *text, const lv_font_t *font, lv_coord_t letter_space)
+{
+    struct text_sprite *free_entry = NULL;
+
+    use_counter++;
+
+    for (int i = 0; i < TEXT_SPRITE_ENTRIES; i++)
+    {
+        struct text_sprite *sprite = &sprites[i];
+
+        if (sprite->img.data == NULL)
+        {
+            free_entry = free_entry ? free_entry : sprite;
+        }
+        else if (sprite->font == font && sprite->letter_space == letter_space &&
+                 strcmp(sprite->text, text) == 0)
+        {
+            sprite->last_used = use_counter;
+            return &sprite->img;
+        }
+    }
+
+    if (free_entry == NULL)
+    {
+        free_entry = least_recently_used();
+        text_sprite_evict(free_entry);
+    }
+
+    free_entry->font = font;
+    free_entry->letter_space = letter_space;
+    free_entry->last_used = use_counter;
+
+    if (!text_sprite_render(free_entry, text))
+    {
+        return NULL;
+    }
+    return &free_entry->img;
+}
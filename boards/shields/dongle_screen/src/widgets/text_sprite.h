@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Get a pre-rendered image of a static text
+ *
+ * The text is rasterised once into an 8 bit alpha image (LV_IMG_CF_ALPHA_8BIT) and kept in a RAM
+ * cache of CONFIG_DONGLE_SCREEN_LAYER_SPRITE_CACHE_SIZE bytes, least recently used sprites are
+ * evicted first. Showing the text again is a plain blit of the alpha mask, drawn in the
+ * img_recolor color of the image object.
+ *
+ * @param text Text to render, cached by content
+ * @param font Font to render with
+ * @param letter_space Extra space between letters, as the label's text_letter_space
+ * @return The sprite, or NULL if it does not fit into the cache
+ */
+const lv_img_dsc_t *text_sprite_get(const char *text, const lv_font_t *font, lv_coord_t letter_space);
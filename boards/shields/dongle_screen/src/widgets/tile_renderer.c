@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "tile_renderer.h"
+
+#if LV_COLOR_DEPTH != 16
+#error "The tile renderer writes RGB565 pixels"
+#endif
+
+// Same color as the screen background
+#define TILE_BACKGROUND lv_color_black()
+#define TILE_BUFFER_PIXELS (CONFIG_DONGLE_SCREEN_TILE_BUFFER_SIZE / sizeof(lv_color_t))
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// Shared by all tiles, pixels in the format LVGL flushes (including LV_COLOR_16_SWAP)
+static lv_color_t tile_buffer[TILE_BUFFER_PIXELS];
+
+static void tile_repaint_work(struct k_work *work)
+{
+    struct tile *tile = CONTAINER_OF(work, struct tile, repaint_work);
+
+    if (tile_shown(tile))
+    {
+        tile->repaint(tile);
+    }
+}
+
+// LVGL cleared the area with the background, the tile is drawn again after the frame was flushed
+static void tile_draw_cb(lv_event_t *e)
+{
+    struct tile *tile = lv_event_get_user_data(e);
+
+    lv_obj_get_coords(tile->obj, &tile->area);
+    tile->shown = true;
+    k_work_submit_to_queue(zmk_display_work_q(), &tile->repaint_work);
+}
+
+static void tile_delete_cb(lv_event_t *e)
+{
+    struct tile *tile = lv_event_get_user_data(e);
+
+    tile->shown = false;
+    k_work_cancel(&tile->repaint_work);
+}
+
+void tile_init(struct tile *tile, lv_obj_t *obj, void (*repaint)(struct tile *tile))
+{
+    tile->obj = obj;
+    tile->shown = false;
+    tile->repaint = repaint;
+    k_work_init(&tile->repaint_work, tile_repaint_work);
+
+    lv_obj_add_event_cb(obj, tile_draw_cb, LV_EVENT_DRAW_MAIN, tile);
+    lv_obj_add_event_cb(obj, tile_delete_cb, LV_EVENT_DELETE, tile);
+}
+
+// Writes the first rows * width pixels of the buffer at a tile relative position
+static void tile_write(const struct tile *tile, lv_coord_t x, lv_coord_t y, lv_coord_t width, lv_coord_t rows)
+{
+    const struct display_buffer_descriptor desc = {
+        .buf_size = width * rows * sizeof(lv_color_t),
+        .width = width,
+        .height = rows,
+        .pitch = width,
+    };
+
+    int ret = display_write(display, tile->area.x1 + x, tile->area.y1 + y, &desc, tile_buffer);
+    if (ret < 0)
+    {
+        LOG_WRN("Tile write failed: %d", ret);
+    }
+}
+
+// Clip a rectangle to the tile and the buffer width, returns the rows per buffer, 0 if nothing is left
+static lv_coord_t tile_clip(const struct tile *tile, lv_coord_t x, lv_coord_t y, lv_coord_t *width,
+                            lv_coord_t *height)
+{
+    *width = MIN(MIN(*width, lv_area_get_width(&tile->area) - x), (lv_coord_t)TILE_BUFFER_PIXELS);
+    *height = MIN(*height, lv_area_get_height(&tile->area) - y);
+
+    return *width > 0 && *height > 0 ? TILE_BUFFER_PIXELS / *width : 0;
+}
+
+void tile_fill(const struct tile *tile, lv_coord_t x, lv_coord_t y, lv_coord_t width, lv_coord_t height,
+               lv_color_t color)
+{
+    lv_coord_t strip = tile_clip(tile, x, y, &width, &height);
+
+    if (!tile_shown(tile) || strip == 0)
+    {
+        return;
+    }
+
+    // Every strip has the same content, the buffer is only filled once
+    lv_coord_t rows = MIN(strip, height);
+    for (int i = 0; i < rows * width; i++)
+    {
+        tile_buffer[i] = color;
+    }
+
+    for (lv_coord_t row = 0; row < height; row += rows)
+    {
+        tile_write(tile, x, y + row, width, MIN(rows, height - row));
+    }
+}
+
+// Alpha of a glyph pixel, bitmaps are packed without row padding
+static lv_opa_t glyph_opa(const uint8_t *bitmap, uint8_t bpp, uint32_t index)
+{
+    uint32_t bit = index * bpp;
+    uint8_t mask = (1 << bpp) - 1;
+    uint8_t value = (bitmap[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+
+    return bpp == 8 ? value : value * LV_OPA_COVER / mask;
+}
+
+void tile_draw_letter(const struct tile *tile, lv_coord_t x, lv_coord_t width, const lv_font_t *font,
+                      uint32_t letter, lv_color_t color)
+{
+    lv_coord_t height = lv_font_get_line_height(font);
+    lv_coord_t strip = tile_clip(tile, x, 0, &width, &height);
+
+    if (!tile_shown(tile) || strip == 0)
+    {
+        return;
+    }
+
+    lv_font_glyph_dsc_t glyph;
+    const uint8_t *bitmap = NULL;
+    if (letter != ' ' && lv_font_get_glyph_dsc(font, &glyph, letter, 0))
+    {
+        const lv_font_t *resolved = glyph.resolved_font != NULL ? glyph.resolved_font : font;
+        bitmap = lv_font_get_glyph_bitmap((lv_font_t *)resolved, letter);
+    }
+
+    // Same placement as lv_draw_letter(), centered like digit_display
+    lv_coord_t glyph_x = 0;
+    lv_coord_t glyph_y = 0;
+    if (bitmap != NULL)
+    {
+        glyph_x = (width - glyph.adv_w) / 2 + glyph.ofs_x;
+        glyph_y = font->line_height - font->base_line - glyph.box_h - glyph.ofs_y;
+    }
+
+    for (lv_coord_t row = 0; row < height; row += strip)
+    {
+        lv_coord_t rows = MIN(strip, height - row);
+
+        for (lv_coord_t r = 0; r < rows; r++)
+        {
+            lv_color_t *line = &tile_buffer[r * width];
+            lv_coord_t gy = row + r - glyph_y;
+
+            for (lv_coord_t c = 0; c < width; c++)
+            {
+                lv_coord_t gx = c - glyph_x;
+
+                if (bitmap == NULL || gx < 0 || gx >= glyph.box_w || gy < 0 || gy >= glyph.box_h)
+                {
+                    line[c] = TILE_BACKGROUND;
+                    continue;
+                }
+
+                lv_opa_t opa = glyph_opa(bitmap, glyph.bpp, gy * glyph.box_w + gx);
+                line[c] = lv_color_mix(color, TILE_BACKGROUND, opa);
+            }
+        }
+
+        tile_write(tile, x, row, width, rows);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief A fixed screen area drawn straight to the panel with display_write()
+ *
+ * The tile is backed by an LVGL object that only reserves its place on the screen: LVGL positions
+ * it and clears it with the screen background, but never draws its content. Updates are drawn
+ * into a small scratch buffer and written to the panel right away, without an LVGL refresh.
+ * Whenever LVGL redraws the area (the screen was created, shown again, ...) the repaint callback
+ * draws the whole tile again, once LVGL flushed its frame.
+ *
+ * All drawing runs on the display work queue, like the LVGL refresh, so the two never interleave.
+ */
+struct tile
+{
+    lv_obj_t *obj;
+    lv_area_t area; // Screen coordinates of obj, valid once shown
+    bool shown;
+    struct k_work repaint_work;
+    void (*repaint)(struct tile *tile);
+};
+
+/**
+ * @brief Bind a tile to the object reserving its area
+ * @param repaint Draws the whole tile, called after LVGL drew the area
+ */
+void tile_init(struct tile *tile, lv_obj_t *obj, void (*repaint)(struct tile *tile));
+
+/**
+ * @brief Whether the tile is on the screen, until then updates are left to the repaint
+ *
+ * A hidden object is not on the screen either, its area may belong to another object.
+ */
+static inline bool tile_shown(const struct tile *tile)
+{
+    return tile->shown && !lv_obj_has_flag(tile->obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * @brief Fill a rectangle, in coordinates relative to the tile
+ */
+void tile_fill(const struct tile *tile, lv_coord_t x, lv_coord_t y, lv_coord_t width, lv_coord_t height,
+               lv_color_t color);
+
+/**
+ * @brief Draw a letter centered in a character cell of the given width, top aligned in the tile
+ *
+ * The whole cell is written, the pixels around the glyph get the background color, so the cell
+ * never needs to be cleared first. A letter missing in the font leaves the cell empty.
+ */
+void tile_draw_letter(const struct tile *tile, lv_coord_t x, lv_coord_t width, const lv_font_t *font,
+                      uint32_t letter, lv_color_t color);
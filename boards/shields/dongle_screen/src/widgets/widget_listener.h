@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+
+#include "render_scheduler.h"
+#include "../profiler.h"
+
+/**
+ * @brief Drop-in replacement for ZMK_DISPLAY_WIDGET_LISTENER which only
+ * calls the update callback when the widget state actually changed.
+ *
+ * New states are compared with memcmp against the pending state (to avoid
+ * scheduling a frame at all) and against the last applied state (to drop A -> B -> A
+ * sequences that collapsed before the frame ran). The state struct must therefore
+ * be free of padding bytes; declare it __packed if needed.
+ *
+ * The pending state is a latest-wins mailbox: changed states only mark the
+ * widget dirty in the render scheduler, which calls the update callback once
+ * per frame slot with whatever state is newest at that point.
+ */
+#define DONGLE_SCREEN_WIDGET_LISTENER(listener, state_type, cb, state_func)                        \
+    K_MUTEX_DEFINE(listener##_mutex);                                                              \
+    static state_type __##listener##_state;                                                        \
+    static state_type __##listener##_applied;                                                      \
+    static bool __##listener##_has_applied;                                                        \
+    static void listener##_refresh(void)                                                           \
+    {                                                                                              \
+        k_mutex_lock(&listener##_mutex, K_FOREVER);                                                \
+        state_type copy = __##listener##_state;                                                    \
+        k_mutex_unlock(&listener##_mutex);                                                         \
+        if (__##listener##_has_applied &&                                                          \
+            memcmp(&copy, &__##listener##_applied, sizeof(state_type)) == 0)                       \
+        {                                                                                          \
+            profiler_count(PROFILER_SUPPRESSED_UPDATES);                                           \
+            return;                                                                                \
+        }                                                                                          \
+        __##listener##_applied = copy;                                                             \
+        __##listener##_has_applied = true;                                                         \
+        profiler_count(PROFILER_WIDGET_RENDERS);                                                   \
+        cb(copy);                                                                                  \
+    }                                                                                              \
+    static struct render_slot listener##_slot = {.refresh = listener##_refresh};                  \
+    static void listener##_init()                                                                  \
+    {                                                                                              \
+        k_mutex_lock(&listener##_mutex, K_FOREVER);                                                \
+        __##listener##_state = state_func(NULL);                                                   \
+        __##listener##_has_applied = false;                                                        \
+        k_mutex_unlock(&listener##_mutex);                                                         \
+        render_scheduler_register(&listener##_slot);                                               \
+        listener##_refresh();                                                                      \
+    }                                                                                              \
+    static int listener##_cb(const zmk_event_t *eh)                                                \
+    {                                                                                              \
+        if (zmk_display_is_initialized())                                                          \
+        {                                                                                          \
+            state_type new_state = state_func(eh);                                                 \
+            k_mutex_lock(&listener##_mutex, K_FOREVER);                                            \
+            bool changed = memcmp(&new_state, &__##listener##_state, sizeof(state_type)) != 0;     \
+            if (changed)                                                                           \
+            {                                                                                      \
+                __##listener##_state = new_state;                                                  \
+            }                                                                                      \
+            k_mutex_unlock(&listener##_mutex);                                                     \
+            if (changed)                                                                           \
+            {                                                                                      \
+                render_scheduler_mark_dirty(&listener##_slot);                                     \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                profiler_count(PROFILER_SUPPRESSED_UPDATES);                                       \
+            }                                                                                      \
+        }                                                                                          \
+        return ZMK_EV_EVENT_BUBBLE;                                                                \
+    }                                                                                              \
+    ZMK_LISTENER(listener, listener##_cb);
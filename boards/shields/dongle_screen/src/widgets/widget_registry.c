@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include "widget_registry.h"
+
+void widget_registry_create_all(lv_obj_t *parent)
+{
+    // Widgets register themselves, the section is sorted by priority
+    STRUCT_SECTION_FOREACH(dongle_screen_widget, widget)
+    {
+        lv_obj_t *obj = widget->create(parent);
+        if (obj == NULL)
+        {
+            LOG_ERR("Failed to create the %s widget", widget->name);
+            continue;
+        }
+        screen_layout_place(obj, &widget->layout[screen_layout_current()]);
+    }
+}
+
+void widget_registry_place_all(void)
+{
+    STRUCT_SECTION_FOREACH(dongle_screen_widget, widget)
+    {
+        lv_obj_t *obj = widget->obj();
+        if (obj != NULL)
+        {
+            screen_layout_place(obj, &widget->layout[screen_layout_current()]);
+        }
+    }
+}
+
+void widget_registry_destroy_all(void)
+{
+    STRUCT_SECTION_FOREACH(dongle_screen_widget, widget)
+    {
+        widget->destroy();
+    }
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+static int cmd_widgets(const struct shell *sh, size_t argc, char **argv)
+{
+    STRUCT_SECTION_FOREACH(dongle_screen_widget, widget)
+    {
+        const struct screen_box *box = &widget->layout[screen_layout_current()];
+
+        shell_print(sh, "%-16s priority %2u  %3dx%-3d at %3d,%-3d  %u bytes", widget->name, widget->priority,
+                    box->width, box->height, box->x, box->y, (unsigned int)widget->ram_size);
+    }
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((dongle_screen), widgets, NULL, "List the registered widgets", cmd_widgets, 1, 0);
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#include "../screen_layout.h"
+
+/**
+ * @brief A widget of the status screen, registered by the widget itself
+ *
+ * Entries live in an iterable section sorted by priority, the status screen creates them in that
+ * order. Widgets register their render slot while being created, so the render scheduler also
+ * refreshes them in priority order.
+ */
+struct dongle_screen_widget
+{
+    const char *name;
+    lv_obj_t *(*create)(lv_obj_t *parent); // Returns the widget object, NULL on failure
+    void (*destroy)(void);                  // Deletes the widget objects, the widget keeps its state
+    lv_obj_t *(*obj)(void);                 // The widget object, NULL while the widget is not created
+    struct screen_box layout[SCREEN_LAYOUT_COUNT]; // As given by SCREEN_LAYOUT_*
+    size_t ram_size; // Size of the static widget instance
+    uint8_t priority;
+};
+
+/**
+ * @brief Register a widget with the status screen
+ *
+ * Defines the static widget instance of type widget_type, which must have an obj member,
+ * and a registry entry creating it with init_fn(&instance, parent).
+ * Compile the widget only when it is enabled, a disabled widget then costs nothing.
+ *
+ * @param id Name of the widget, unique
+ * @param prio Creation and refresh priority (10-99), lower comes first. Two digits, as the
+ *             entries are sorted by name
+ * @param widget_type Type of the widget instance
+ * @param init_fn Init function of the widget, int init_fn(widget_type *, lv_obj_t *)
+ * @param deinit_fn Counterpart of init_fn, void deinit_fn(widget_type *). Must stop everything
+ *                  touching the objects, init_fn is called again when the widget is rebuilt.
+ * @param box Boxes of the widget, one of the SCREEN_LAYOUT_* macros
+ */
+#define DONGLE_SCREEN_WIDGET_DEFINE(id, prio, widget_type, init_fn, deinit_fn, box)                \
+    static widget_type id##_instance;                                                              \
+    static lv_obj_t *id##_create(lv_obj_t *parent)                                                 \
+    {                                                                                              \
+        return init_fn(&id##_instance, parent) < 0 ? NULL : id##_instance.obj;                     \
+    }                                                                                              \
+    static void id##_destroy(void)                                                                 \
+    {                                                                                              \
+        deinit_fn(&id##_instance);                                                                 \
+    }                                                                                              \
+    static lv_obj_t *id##_obj(void)                                                                \
+    {                                                                                              \
+        return id##_instance.obj;                                                                  \
+    }                                                                                              \
+    const STRUCT_SECTION_ITERABLE_NAMED(dongle_screen_widget, prio##_##id, id##_widget) = {        \
+        .name = #id,                                                                               \
+        .create = id##_create,                                                                     \
+        .destroy = id##_destroy,                                                                   \
+        .obj = id##_obj,                                                                           \
+        .layout = {box},                                                                           \
+        .ram_size = sizeof(widget_type),                                                           \
+        .priority = prio,                                                                          \
+    }
+
+/**
+ * @brief Create all registered widgets in priority order and put them into their boxes
+ */
+void widget_registry_create_all(lv_obj_t *parent);
+
+/**
+ * @brief Delete the objects of all registered widgets, e.g. before another page is shown
+ */
+void widget_registry_destroy_all(void);
+
+/**
+ * @brief Move the created widgets into their boxes of the current layout, e.g. after a rotation
+ */
+void widget_registry_place_all(void);
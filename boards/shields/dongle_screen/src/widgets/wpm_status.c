@@ -12,8 +12,14 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/wpm_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
 
 #include "wpm_status.h"
+#include "widget_listener.h"
+#include "widget_registry.h"
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_ENGINE)
+#include "../wpm_engine.h"
+#endif
 #include <fonts.h>
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
@@ -22,6 +28,8 @@ struct wpm_status_state
     int wpm;
 };
 
+#if !IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_ENGINE)
+
 static struct wpm_status_state get_state(const zmk_event_t *_eh)
 {
     const struct zmk_wpm_state_changed *ev = as_zmk_wpm_state_changed(_eh);
@@ -30,12 +38,145 @@ static struct wpm_status_state get_state(const zmk_event_t *_eh)
         .wpm = ev ? ev->state : 0};
 }
 
+#else
+
+// The local rate decays without key presses, so while it is above zero the state is
+// re-evaluated periodically. The listener drops the refresh if the value did not change.
+#define WPM_DECAY_REFRESH_MS 250
+
+static int widget_wpm_status_cb(const zmk_event_t *eh);
+
+static void wpm_decay_refresh(struct k_work *work)
+{
+    widget_wpm_status_cb(NULL);
+}
+
+K_WORK_DELAYABLE_DEFINE(wpm_decay_work, wpm_decay_refresh);
+
+static struct wpm_status_state get_state(const zmk_event_t *_eh)
+{
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_SOURCE_LOCAL_KPS)
+    int wpm = wpm_engine_kps();
+#else
+    int wpm = wpm_engine_wpm();
+#endif
+
+    if (wpm > 0)
+    {
+        k_work_schedule(&wpm_decay_work, K_MSEC(WPM_DECAY_REFRESH_MS));
+    }
+
+    return (struct wpm_status_state){
+        .wpm = wpm};
+}
+
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_GRAPH)
+
+// Sparkline of the last samples drawn as a sweep: the newest sample is written over the
+// oldest one at the cursor and the column after it is kept empty to mark the position.
+// So every sample only invalidates two narrow columns instead of shifting the whole chart.
+#define GRAPH_SAMPLES CONFIG_DONGLE_SCREEN_WPM_GRAPH_SAMPLES
+#define GRAPH_COLUMN_WIDTH 2
+#define GRAPH_WIDTH (GRAPH_SAMPLES * GRAPH_COLUMN_WIDTH)
+#define GRAPH_HEIGHT 24
+
+static uint8_t graph_heights[GRAPH_SAMPLES];
+static uint16_t graph_cursor;
+static uint16_t graph_idle_samples;
+static int graph_value;
+
+static void wpm_graph_sample(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(wpm_graph_work, wpm_graph_sample);
+
+static void wpm_graph_invalidate_column(lv_obj_t *graph, uint16_t column)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(graph, &coords);
+
+    lv_area_t area = {
+        .x1 = coords.x1 + column * GRAPH_COLUMN_WIDTH,
+        .y1 = coords.y1,
+        .x2 = coords.x1 + (column + 1) * GRAPH_COLUMN_WIDTH - 1,
+        .y2 = coords.y2,
+    };
+    lv_obj_invalidate_area(graph, &area);
+}
+
+static void wpm_graph_draw_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_white();
+
+    uint16_t gap = (graph_cursor + 1) % GRAPH_SAMPLES;
+
+    for (uint16_t i = 0; i < GRAPH_SAMPLES; i++)
+    {
+        lv_coord_t x1 = coords.x1 + i * GRAPH_COLUMN_WIDTH;
+
+        // Only columns within the invalidated area need to be drawn
+        if (i == gap || graph_heights[i] == 0 || x1 > draw_ctx->clip_area->x2 ||
+            x1 + GRAPH_COLUMN_WIDTH - 1 < draw_ctx->clip_area->x1)
+        {
+            continue;
+        }
+
+        lv_area_t column = {
+            .x1 = x1,
+            .y1 = coords.y2 - graph_heights[i] + 1,
+            .x2 = x1 + GRAPH_COLUMN_WIDTH - 1,
+            .y2 = coords.y2,
+        };
+        lv_draw_rect(draw_ctx, &dsc, &column);
+    }
+}
+
+static void wpm_graph_sample(struct k_work *work)
+{
+    struct zmk_widget_wpm_status *widget;
+
+    graph_cursor = (graph_cursor + 1) % GRAPH_SAMPLES;
+    graph_heights[graph_cursor] =
+        MIN(graph_value, CONFIG_DONGLE_SCREEN_WPM_GRAPH_MAX) * GRAPH_HEIGHT / CONFIG_DONGLE_SCREEN_WPM_GRAPH_MAX;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node)
+    {
+        wpm_graph_invalidate_column(widget->graph, graph_cursor);
+        wpm_graph_invalidate_column(widget->graph, (graph_cursor + 1) % GRAPH_SAMPLES);
+    }
+
+    // Stop sampling once the whole graph is flat, set_wpm() restarts it
+    graph_idle_samples = graph_value > 0 ? 0 : graph_idle_samples + 1;
+    if (graph_idle_samples < GRAPH_SAMPLES)
+    {
+        k_work_schedule_for_queue(zmk_display_work_q(), &wpm_graph_work,
+                                  K_MSEC(CONFIG_DONGLE_SCREEN_WPM_GRAPH_INTERVAL_MS));
+    }
+}
+
+#endif
+
 static void set_wpm(struct zmk_widget_wpm_status *widget, struct wpm_status_state state)
 {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_GRAPH)
+    graph_value = state.wpm;
+    if (state.wpm > 0)
+    {
+        graph_idle_samples = 0;
+        k_work_schedule_for_queue(zmk_display_work_q(), &wpm_graph_work,
+                                  K_MSEC(CONFIG_DONGLE_SCREEN_WPM_GRAPH_INTERVAL_MS));
+    }
+#endif
 
-    char wpm_text[12];
-    snprintf(wpm_text, sizeof(wpm_text), "%i", state.wpm);
-    lv_label_set_text(widget->wpm_label, wpm_text);
+    digit_display_set_value(&widget->wpm_digits, MIN(state.wpm, 999));
 }
 
 static void wpm_status_update_cb(struct wpm_status_state state)
@@ -47,18 +188,28 @@ static void wpm_status_update_cb(struct wpm_status_state state)
     }
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state,
+DONGLE_SCREEN_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state,
                             wpm_status_update_cb, get_state)
+#if !IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_ENGINE)
 ZMK_SUBSCRIPTION(widget_wpm_status, zmk_wpm_state_changed);
+#else
+ZMK_SUBSCRIPTION(widget_wpm_status, zmk_keycode_state_changed);
+#endif
 
 // output_status.c
 int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *parent)
 {
-    widget->obj = lv_obj_create(parent);
-    lv_obj_set_size(widget->obj, 240, 77);
+    widget->obj = screen_layout_obj_create(parent);
 
-    widget->wpm_label = lv_label_create(widget->obj);
-    lv_obj_align(widget->wpm_label, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_t *wpm_digits = digit_display_create(&widget->wpm_digits, widget->obj, NULL, 3, DIGIT_DISPLAY_ALIGN_LEFT);
+    lv_obj_align(wpm_digits, LV_ALIGN_TOP_LEFT, 0, 0);
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_WPM_GRAPH)
+    widget->graph = screen_layout_obj_create(widget->obj);
+    lv_obj_set_size(widget->graph, GRAPH_WIDTH, GRAPH_HEIGHT);
+    lv_obj_align(widget->graph, LV_ALIGN_TOP_LEFT, 0, 28);
+    lv_obj_add_event_cb(widget->graph, wpm_graph_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+#endif
 
     // Only here as a sample
     // widget->font_test = lv_label_create(widget->obj);
@@ -75,7 +226,21 @@ int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *p
     return 0;
 }
 
+void zmk_widget_wpm_status_deinit(struct zmk_widget_wpm_status *widget)
+{
+    sys_slist_find_and_remove(&widgets, &widget->node);
+    if (widget->obj != NULL)
+    {
+        lv_obj_del(widget->obj);
+        widget->obj = NULL;
+    }
+}
+
 lv_obj_t *zmk_widget_wpm_status_obj(struct zmk_widget_wpm_status *widget)
 {
     return widget->obj;
 }
+
+DONGLE_SCREEN_WIDGET_DEFINE(wpm_status, 30, struct zmk_widget_wpm_status,
+                            zmk_widget_wpm_status_init, zmk_widget_wpm_status_deinit,
+                            SCREEN_LAYOUT_WPM);
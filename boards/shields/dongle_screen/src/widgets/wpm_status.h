@@ -9,13 +9,17 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "digit_display.h"
+
 struct zmk_widget_wpm_status
 {
     lv_obj_t *obj;
-    lv_obj_t *wpm_label;
+    struct digit_display wpm_digits;
+    lv_obj_t *graph;
     lv_obj_t *font_test;
     sys_snode_t node;
 };
 
 int zmk_widget_wpm_status_init(struct zmk_widget_wpm_status *widget, lv_obj_t *parent);
+void zmk_widget_wpm_status_deinit(struct zmk_widget_wpm_status *widget);
 lv_obj_t *zmk_widget_wpm_status_obj(struct zmk_widget_wpm_status *widget);
\ No newline at end of file
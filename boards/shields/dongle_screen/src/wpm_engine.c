@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "wpm_engine.h"
+
+// Key presses are counted in a ring of 100ms buckets covering the window, together with a
+// running total. Recording a key and reading the rate only clear the buckets that expired
+// since the last call, so both are O(1) amortized and nothing is allocated.
+#define BUCKET_MS 100
+#define WINDOW_BUCKETS (CONFIG_DONGLE_SCREEN_WPM_WINDOW_MS / BUCKET_MS)
+#define KPS_BUCKETS (1000 / BUCKET_MS)
+#define KEYS_PER_WORD 5
+
+BUILD_ASSERT(WINDOW_BUCKETS >= KPS_BUCKETS, "The WPM window must cover at least one second");
+
+static uint8_t buckets[WINDOW_BUCKETS];
+static int64_t newest_bucket; // Absolute bucket number (uptime / BUCKET_MS) of the newest bucket
+static uint32_t window_total;
+static struct k_spinlock lock;
+
+static void advance_to(int64_t bucket)
+{
+    if (bucket - newest_bucket >= WINDOW_BUCKETS)
+    {
+        memset(buckets, 0, sizeof(buckets));
+        window_total = 0;
+    }
+    else
+    {
+        for (int64_t b = newest_bucket + 1; b <= bucket; b++)
+        {
+            window_total -= buckets[b % WINDOW_BUCKETS];
+            buckets[b % WINDOW_BUCKETS] = 0;
+        }
+    }
+
+    newest_bucket = MAX(newest_bucket, bucket);
+}
+
+uint16_t wpm_engine_wpm(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    advance_to(k_uptime_get() / BUCKET_MS);
+    uint32_t total = window_total;
+    k_spin_unlock(&lock, key);
+
+    return total * 60000 / CONFIG_DONGLE_SCREEN_WPM_WINDOW_MS / KEYS_PER_WORD;
+}
+
+uint16_t wpm_engine_kps(void)
+{
+    uint16_t kps = 0;
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    advance_to(k_uptime_get() / BUCKET_MS);
+    // Within the first second of uptime there are fewer buckets than a second, newest_bucket - i
+    // would be negative for the missing ones
+    for (int i = 0; i < MIN(KPS_BUCKETS, newest_bucket + 1); i++)
+    {
+        kps += buckets[(newest_bucket - i) % WINDOW_BUCKETS];
+    }
+    k_spin_unlock(&lock, key);
+
+    return kps;
+}
+
+static int wpm_engine_listener(const zmk_event_t *eh)
+{
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+    if (ev && ev->state)
+    {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        advance_to(k_uptime_get() / BUCKET_MS);
+        uint8_t *bucket = &buckets[newest_bucket % WINDOW_BUCKETS];
+        if (*bucket < UINT8_MAX)
+        {
+            (*bucket)++;
+            window_total++;
+        }
+        k_spin_unlock(&lock, key);
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+// Listeners run in name order, so this is called before the WPM widget sees the same key event
+ZMK_LISTENER(dongle_wpm_engine, wpm_engine_listener);
+ZMK_SUBSCRIPTION(dongle_wpm_engine, zmk_keycode_state_changed);
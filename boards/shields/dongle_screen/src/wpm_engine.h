@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Words per minute over the last CONFIG_DONGLE_SCREEN_WPM_WINDOW_MS
+ * Computed on the dongle from the key presses, a word counts as five key presses.
+ */
+uint16_t wpm_engine_wpm(void);
+
+/**
+ * @brief Key presses within the last second
+ */
+uint16_t wpm_engine_kps(void);
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Plans a fade between every pair of brightness percentages and checks that it only moves towards
+// its target, ends on it exactly and is paced by evenly spaced deadlines.
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+
+#include "brightness_fade.h"
+
+static int check_tables(void)
+{
+    for (size_t i = 1; i < ARRAY_SIZE(brightness_lightness); i++)
+    {
+        if (brightness_lightness[i] <= brightness_lightness[i - 1])
+        {
+            fprintf(stderr, "lightness of %zu%% is not above the one of %zu%%\n", i, i - 1);
+            return 1;
+        }
+    }
+    for (size_t i = 1; i < ARRAY_SIZE(fade_ease); i++)
+    {
+        if (fade_ease[i] < fade_ease[i - 1])
+        {
+            fprintf(stderr, "easing sample %zu is below the one before\n", i);
+            return 1;
+        }
+    }
+    if (fade_ease[0] != 0 || fade_ease[FADE_EASE_SEGMENTS] != FADE_EASE_ONE)
+    {
+        fprintf(stderr, "easing does not run from 0 to FADE_EASE_ONE\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int check_fade(uint8_t from, uint8_t to)
+{
+    struct brightness_fade fade;
+    uint8_t previous = from;
+
+    brightness_fade_plan(&fade, from, to);
+
+    for (int i = 0; i <= fade.steps; i++)
+    {
+        uint8_t brightness = brightness_fade_step(&fade, i);
+
+        // Never back, never past the target
+        if ((to > from && (brightness < previous || brightness > to)) ||
+            (to < from && (brightness > previous || brightness < to)) || (to == from && brightness != to))
+        {
+            fprintf(stderr, "%u to %u: step %d of %u goes from %u to %u\n", from, to, i, fade.steps, previous,
+                    brightness);
+            return 1;
+        }
+        if ((i == 0 && brightness != from) || (i == fade.steps && brightness != to))
+        {
+            fprintf(stderr, "%u to %u: step %d of %u is %u\n", from, to, i, fade.steps, brightness);
+            return 1;
+        }
+        previous = brightness;
+    }
+
+    // Every interval is the ideal one rounded down or up
+    uint32_t interval = fade.total_duration_ms / fade.steps;
+    uint32_t previous_deadline = brightness_fade_deadline_ms(&fade, 0);
+
+    if (previous_deadline != 0)
+    {
+        fprintf(stderr, "%u to %u: the first step is due after %u ms\n", from, to, previous_deadline);
+        return 1;
+    }
+    for (int i = 1; i <= fade.steps; i++)
+    {
+        uint32_t deadline = brightness_fade_deadline_ms(&fade, i);
+
+        if (deadline - previous_deadline < interval || deadline - previous_deadline > interval + 1)
+        {
+            fprintf(stderr, "%u to %u: step %d of %u is due %u ms after the one before, not %u\n", from, to, i,
+                    fade.steps, deadline - previous_deadline, interval);
+            return 1;
+        }
+        previous_deadline = deadline;
+    }
+    if (previous_deadline != fade.total_duration_ms)
+    {
+        fprintf(stderr, "%u to %u: the last step is due after %u ms, not %u\n", from, to, previous_deadline,
+                fade.total_duration_ms);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failed = check_tables();
+
+    for (int from = 0; from <= 100; from++)
+    {
+        for (int to = 0; to <= 100; to++)
+        {
+            failed |= check_fade(from, to);
+        }
+    }
+    if (failed)
+    {
+        return failed;
+    }
+
+    printf("fades between all %d pairs of brightness percentages are monotonic and evenly paced\n", 101 * 101);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Write the modifier icons in every format of CONFIG_DONGLE_SCREEN_MOD_ICON_FORMAT for glyph_blit_bench.c.
+
+The glyph bitmaps are requantized and the images pre-blended by the same code the firmware build
+uses (scripts/subset_lv_font.py), from the checked in NerdFont.
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "scripts"))
+
+import subset_lv_font  # noqa: E402
+
+ICONS = [("ctrl", 0xF0634), ("shift", 0xF0636), ("alt", 0xF0635), ("gui", 0xF0633)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--input", required=True, help="lv_font_conv C file")
+    parser.add_argument("--output", required=True, help="C file to write")
+    args = parser.parse_args()
+
+    with open(args.input, encoding="utf-8") as f:
+        text = f.read()
+
+    glyphs, _, _ = subset_lv_font.parse_font(text)
+    source = os.path.basename(args.input)
+    src_bpp = subset_lv_font.font_param(text, "bpp")
+    icons = {cp: glyphs[cp] for _, cp in ICONS}
+
+    out = []
+    for rle in (False, True):
+        suffix = "rle" if rle else "rgb565"
+        sprites = [("bench_{}_{}".format(name, suffix), cp) for name, cp in ICONS]
+        out.append(subset_lv_font.write_sprites(text, glyphs, sprites, (0xFF, 0xFF, 0xFF), (0, 0, 0), False,
+                                                rle, source))
+
+    out.append('#include "glyph_blit_bench.h"')
+    out.append("")
+    for bpp in (4, 2, 1):
+        subset = icons if bpp == src_bpp else subset_lv_font.requantize(icons, src_bpp, bpp)
+        for name, cp in ICONS:
+            data = subset[cp][0]
+            out.append("static const uint8_t bench_{}_a{}[] = {{".format(name, bpp))
+            for i in range(0, len(data), 16):
+                out.append("    " + ", ".join(data[i:i + 16]) + ",")
+            out.append("};")
+
+    out.append("")
+    out.append("const struct bench_glyph bench_glyphs[BENCH_ALPHA_FORMATS][BENCH_ICONS] = {")
+    for bpp in (4, 2, 1):
+        out.append("    {")
+        for name, cp in ICONS:
+            dsc = icons[cp][1]
+            out.append("        {{.bpp = {}, .box_w = {}, .box_h = {}, .ofs_x = {}, .ofs_y = {}, .bitmap = bench_{}_a{}}},"
+                       .format(bpp, *(subset_lv_font.glyph_param(dsc, p) for p in ("box_w", "box_h", "ofs_x", "ofs_y")),
+                               name, bpp))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("const lv_img_dsc_t *const bench_images[BENCH_IMAGE_FORMATS][BENCH_ICONS] = {")
+    for suffix in ("rgb565", "rle"):
+        out.append("    {" + ", ".join("&bench_{}_{}".format(name, suffix) for name, _ in ICONS) + "},")
+    out.append("};")
+    out.append("")
+    out.append("const lv_coord_t bench_line_height = {};".format(subset_lv_font.font_param(text, "line_height")))
+    out.append("const lv_coord_t bench_base_line = {};".format(subset_lv_font.font_param(text, "base_line")))
+    out.append("")
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Write images encoded by scripts/rle_image.py together with their raw pixels for rle_image_test.c.
+
+The rows mix runs and literals of every length around the 128 pixel packet limit, so windows
+starting and ending inside runs, literals and packet boundaries all occur.
+"""
+
+import argparse
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "scripts"))
+
+import rle_image  # noqa: E402
+
+
+def pixel(rng, px_size):
+    return bytes(rng.randrange(256) for _ in range(px_size))
+
+
+def mixed_row(rng, width, px_size):
+    row = []
+    while len(row) < width:
+        length = rng.choice([1, 2, 3, 127, 128, 129, 200, rng.randrange(1, 40)])
+        if rng.randrange(2):
+            row.extend([pixel(rng, px_size)] * length)
+        else:
+            # Literal pixels, neighbours never repeat so the encoder cannot form runs
+            for _ in range(length):
+                p = pixel(rng, px_size)
+                while row and p == row[-1]:
+                    p = pixel(rng, px_size)
+                row.append(p)
+    return row[:width]
+
+
+def splash_row(y, width):
+    """A dark background with a few bars and a gradient, roughly what an icon or splash looks like."""
+    row = []
+    for x in range(width):
+        if 40 <= y < 80 and 20 <= x < width - 20:
+            row.append(rle_image.rgb565(255, 255, 255, False))
+        elif 120 <= y < 160:
+            row.append(rle_image.rgb565(x * 255 // width, 64, 255 - x * 255 // width, False))
+        elif (x // 24 + y // 24) % 5 == 0:
+            row.append(rle_image.rgb565(0, 128, 255, False))
+        else:
+            row.append(rle_image.rgb565(0, 0, 0, False))
+    return row
+
+
+def c_array(name, data):
+    out = ["static const uint8_t {}[] = {{".format(name)]
+    for i in range(0, len(data), 16):
+        out.append("    " + ", ".join("0x{:02x}".format(b) for b in data[i:i + 16]) + ",")
+    out.append("};")
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--output", required=True, help="C file to write")
+    args = parser.parse_args()
+
+    rng = random.Random(4242)
+    images = [
+        ("opaque", 2, [mixed_row(rng, 300, 2) for _ in range(6)]),
+        ("alpha", 3, [mixed_row(rng, 300, 3) for _ in range(6)]),
+        ("single", 2, [[pixel(rng, 2)] for _ in range(2)]),
+        ("splash", 2, [splash_row(y, 240) for y in range(280)]),
+    ]
+
+    out = ["/*", " * Generated by gen_rle_vectors.py, do not edit", " */", "", '#include "rle_image_vectors.h"', ""]
+    for name, px_size, rows in images:
+        out.extend(c_array("{}_encoded".format(name), rle_image.encode(rows)))
+        out.extend(c_array("{}_raw".format(name), b"".join(b"".join(row) for row in rows)))
+        out.append("")
+
+    out.append("const struct rle_vector rle_vectors[] = {")
+    for name, px_size, rows in images:
+        out.append("    {{.name = \"{0}\", .width = {1}, .height = {2}, .px_size = {3}, .encoded = {0}_encoded, "
+                   ".encoded_size = sizeof({0}_encoded), .raw = {0}_raw}},".format(name, len(rows[0]), len(rows),
+                                                                                   px_size))
+    out.append("};")
+    out.append("")
+    out.append("const size_t rle_vector_count = ARRAY_SIZE(rle_vectors);")
+    out.append("")
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
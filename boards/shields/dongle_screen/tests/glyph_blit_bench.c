@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Cost of drawing the modifier icons in each CONFIG_DONGLE_SCREEN_MOD_ICON_FORMAT. The alpha
+// formats are drawn like LVGL 8.3 draws letters (expand a row to an 8 bit mask, then blend the text
+// color with lv_color_mix()), the images are copied row by row like opaque true color images, the
+// run-length encoded ones after rle_image_decode_row() decoded the row into a line buffer.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "glyph_blit_bench.h"
+#include "rle_image.h"
+
+#define DEST_WIDTH (BENCH_ICONS * 32)
+#define DEST_HEIGHT 48
+#define ITERATIONS 20000
+#define WHITE 0xFFFF
+
+// LV_OPA_MIN and LV_OPA_MAX, masks outside are skipped or copied without mixing
+#define OPA_MIN 2
+#define OPA_MAX 253
+
+static const uint8_t opa_a1[] = {0, 255};
+static const uint8_t opa_a2[] = {0, 85, 170, 255};
+static const uint8_t opa_a4[] = {0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+
+static const char *const format_names[] = {"A4", "A2", "A1", "RGB565", "RLE"};
+
+static uint16_t dest[DEST_HEIGHT][DEST_WIDTH];
+
+// lv_color_mix() of LVGL 8.3 for 16 bit colors
+static inline uint16_t color_mix(uint16_t fg, uint16_t bg, uint8_t mix)
+{
+    uint32_t m = (mix + 4) >> 3;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x7E0F81F;
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x7E0F81F;
+    uint32_t result = ((((f - b) * m) >> 5) + b) & 0x7E0F81F;
+
+    return (uint16_t)((result >> 16) | result);
+}
+
+static void draw_glyph(const struct bench_glyph *glyph, lv_coord_t x)
+{
+    const uint8_t *opa = glyph->bpp == 4 ? opa_a4 : glyph->bpp == 2 ? opa_a2 : opa_a1;
+    uint8_t value_mask = (1 << glyph->bpp) - 1;
+    lv_coord_t top = bench_line_height - bench_base_line - glyph->box_h - glyph->ofs_y;
+    uint32_t bit = 0;
+    uint8_t mask[64];
+
+    for (lv_coord_t y = 0; y < glyph->box_h; y++)
+    {
+        for (lv_coord_t i = 0; i < glyph->box_w; i++, bit += glyph->bpp)
+        {
+            mask[i] = opa[(glyph->bitmap[bit >> 3] >> (8 - glyph->bpp - (bit & 7))) & value_mask];
+        }
+
+        uint16_t *row = &dest[top + y][x + glyph->ofs_x];
+        for (lv_coord_t i = 0; i < glyph->box_w; i++)
+        {
+            if (mask[i] >= OPA_MAX)
+            {
+                row[i] = WHITE;
+            }
+            else if (mask[i] > OPA_MIN)
+            {
+                row[i] = color_mix(WHITE, row[i], mask[i]);
+            }
+        }
+    }
+}
+
+static void draw_image(const lv_img_dsc_t *img, lv_coord_t x)
+{
+    size_t row_size = img->header.w * sizeof(uint16_t);
+
+    for (lv_coord_t y = 0; y < img->header.h; y++)
+    {
+        memcpy(&dest[y][x], &img->data[y * row_size], row_size);
+    }
+}
+
+static void draw_rle_image(const lv_img_dsc_t *img, lv_coord_t x)
+{
+    uint8_t line[64 * sizeof(uint16_t)];
+
+    for (lv_coord_t y = 0; y < img->header.h; y++)
+    {
+        uint32_t offset = sys_get_le32(&img->data[y * sizeof(uint32_t)]);
+        rle_image_decode_row(&img->data[offset], sizeof(uint16_t), 0, img->header.w, line);
+        memcpy(&dest[y][x], line, img->header.w * sizeof(uint16_t));
+    }
+}
+
+static void draw_icons(int format)
+{
+    for (int i = 0; i < BENCH_ICONS; i++)
+    {
+        lv_coord_t x = i * (DEST_WIDTH / BENCH_ICONS);
+
+        if (format < BENCH_ALPHA_FORMATS)
+        {
+            draw_glyph(&bench_glyphs[format][i], x);
+        }
+        else if (format == BENCH_ALPHA_FORMATS)
+        {
+            draw_image(bench_images[0][i], x);
+        }
+        else
+        {
+            draw_rle_image(bench_images[1][i], x);
+        }
+    }
+}
+
+static size_t format_size(int format)
+{
+    size_t size = 0;
+
+    for (int i = 0; i < BENCH_ICONS; i++)
+    {
+        if (format < BENCH_ALPHA_FORMATS)
+        {
+            const struct bench_glyph *glyph = &bench_glyphs[format][i];
+            size += (glyph->box_w * glyph->box_h * glyph->bpp + 7) / 8;
+        }
+        else
+        {
+            size += bench_images[format - BENCH_ALPHA_FORMATS][i]->data_size;
+        }
+    }
+    return size;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Largest difference of the 5/6 bit channels and the mean difference of the green channel,
+// against the icons drawn from the 4 bpp glyphs
+static void compare(const uint16_t reference[DEST_HEIGHT][DEST_WIDTH], int *max_diff, double *mean_diff)
+{
+    long sum = 0;
+
+    *max_diff = 0;
+    for (int y = 0; y < DEST_HEIGHT; y++)
+    {
+        for (int x = 0; x < DEST_WIDTH; x++)
+        {
+            uint16_t a = reference[y][x];
+            uint16_t b = dest[y][x];
+            int dr = abs((a >> 11) - (b >> 11));
+            int dg = abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F));
+            int db = abs((a & 0x1F) - (b & 0x1F));
+
+            *max_diff = MAX(*max_diff, MAX(dr, MAX(dg, db)));
+            sum += dg;
+        }
+    }
+    *mean_diff = (double)sum / (DEST_WIDTH * DEST_HEIGHT);
+}
+
+int main(void)
+{
+    static uint16_t reference[DEST_HEIGHT][DEST_WIDTH];
+    static uint16_t images[DEST_HEIGHT][DEST_WIDTH];
+    int failed = 0;
+
+    memset(dest, 0, sizeof(dest));
+    draw_icons(0);
+    memcpy(reference, dest, sizeof(dest));
+
+    printf("%-8s %8s %10s %10s %14s\n", "format", "bytes", "ns/icon", "max diff", "mean diff (G)");
+
+    for (int format = 0; format < BENCH_ALPHA_FORMATS + BENCH_IMAGE_FORMATS; format++)
+    {
+        int max_diff;
+        double mean_diff;
+
+        // Drawn onto the black background once for the comparison, then timed
+        memset(dest, 0, sizeof(dest));
+        draw_icons(format);
+        compare(reference, &max_diff, &mean_diff);
+
+        if (format == BENCH_ALPHA_FORMATS)
+        {
+            memcpy(images, dest, sizeof(dest));
+        }
+        else if (format > BENCH_ALPHA_FORMATS && memcmp(images, dest, sizeof(dest)) != 0)
+        {
+            fprintf(stderr, "%s icons differ from the RGB565 icons\n", format_names[format]);
+            failed = 1;
+        }
+
+        double start = now_ns();
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            draw_icons(format);
+        }
+        double ns = (now_ns() - start) / ITERATIONS / BENCH_ICONS;
+
+        printf("%-8s %8zu %10.1f %10d %14.3f\n", format_names[format], format_size(format), ns, max_diff,
+               mean_diff);
+
+        // The pre-blended images must look like the 4 bpp glyphs, up to rounding
+        if (format >= BENCH_ALPHA_FORMATS && max_diff > 2)
+        {
+            fprintf(stderr, "%s icons differ from the 4 bpp glyphs by %d\n", format_names[format], max_diff);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+#define BENCH_ICONS 4
+#define BENCH_ALPHA_FORMATS 3 // A4, A2, A1
+#define BENCH_IMAGE_FORMATS 2 // RGB565, RLE
+
+// A glyph as lv_font_conv stores it: box_w x box_h pixels packed MSB first without row padding
+struct bench_glyph
+{
+    uint8_t bpp;
+    lv_coord_t box_w, box_h;
+    lv_coord_t ofs_x, ofs_y;
+    const uint8_t *bitmap;
+};
+
+// Written by gen_glyph_blit_data.py
+extern const struct bench_glyph bench_glyphs[BENCH_ALPHA_FORMATS][BENCH_ICONS];
+extern const lv_img_dsc_t *const bench_images[BENCH_IMAGE_FORMATS][BENCH_ICONS];
+extern const lv_coord_t bench_line_height;
+extern const lv_coord_t bench_base_line;
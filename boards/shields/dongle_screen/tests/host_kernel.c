@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zmk/display.h>
+
+#define HOST_KERNEL_MAX_WORK 8
+
+static int64_t now_ms;
+static struct k_work_delayable *scheduled[HOST_KERNEL_MAX_WORK];
+static struct k_work_q display_work_q;
+
+int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork, k_timeout_t delay)
+{
+    ARG_UNUSED(queue);
+
+    if (dwork->scheduled)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < HOST_KERNEL_MAX_WORK; i++)
+    {
+        if (scheduled[i] == NULL)
+        {
+            scheduled[i] = dwork;
+            dwork->scheduled = true;
+            dwork->due_ms = now_ms + delay.ms;
+            return 1;
+        }
+    }
+
+    fprintf(stderr, "host_kernel: more than %d delayed work items\n", HOST_KERNEL_MAX_WORK);
+    abort();
+}
+
+void host_kernel_run_until(int64_t ms)
+{
+    while (true)
+    {
+        int next = -1;
+
+        for (int i = 0; i < HOST_KERNEL_MAX_WORK; i++)
+        {
+            if (scheduled[i] != NULL && scheduled[i]->due_ms <= ms &&
+                (next < 0 || scheduled[i]->due_ms < scheduled[next]->due_ms))
+            {
+                next = i;
+            }
+        }
+        if (next < 0)
+        {
+            break;
+        }
+
+        struct k_work_delayable *dwork = scheduled[next];
+        scheduled[next] = NULL;
+        dwork->scheduled = false;
+        now_ms = MAX(now_ms, dwork->due_ms);
+        dwork->work.handler(&dwork->work);
+    }
+
+    now_ms = MAX(now_ms, ms);
+}
+
+int64_t k_uptime_get(void) { return now_ms; }
+
+uint32_t k_cycle_get_32(void) { return (uint32_t)now_ms; }
+
+struct k_work_q *zmk_display_work_q(void) { return &display_work_q; }
+
+bool zmk_display_is_initialized(void) { return true; }
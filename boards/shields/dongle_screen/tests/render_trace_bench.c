@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Replays a fast typing trace through DONGLE_SCREEN_WIDGET_LISTENER and the render scheduler and
+// counts the widget renders, compared with one render per event as ZMK_DISPLAY_WIDGET_LISTENER does.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+#include "widget_listener.h"
+
+#define TRACE_DURATION_MS 60000
+#define TRACE_MAX_EVENTS 8192
+#define TRACE_WPM_WINDOW_MS 5000
+
+enum trace_widget
+{
+    TRACE_WPM,
+    TRACE_LAYER,
+    TRACE_MODS,
+    TRACE_WIDGET_COUNT,
+};
+
+static const char *const trace_widget_names[] = {"wpm", "layer", "mods"};
+
+struct trace_event
+{
+    int64_t time;
+    enum trace_widget widget;
+    uint8_t value;
+};
+
+static struct trace_event events[TRACE_MAX_EVENTS];
+static int event_count;
+
+// State the widgets read, as the ZMK state getters would
+static uint8_t trace_values[TRACE_WIDGET_COUNT];
+
+static unsigned int event_counts[TRACE_WIDGET_COUNT];
+static unsigned int changes[TRACE_WIDGET_COUNT];
+static unsigned int renders[TRACE_WIDGET_COUNT];
+static uint8_t rendered[TRACE_WIDGET_COUNT];
+
+struct trace_state
+{
+    uint8_t value;
+};
+
+#define TRACE_WIDGET_LISTENER(name, widget)                                                        \
+    static struct trace_state name##_get_state(const zmk_event_t *eh)                              \
+    {                                                                                              \
+        ARG_UNUSED(eh);                                                                            \
+        return (struct trace_state){.value = trace_values[widget]};                                \
+    }                                                                                              \
+    static void name##_update_cb(struct trace_state state)                                         \
+    {                                                                                              \
+        renders[widget]++;                                                                         \
+        rendered[widget] = state.value;                                                            \
+    }                                                                                              \
+    DONGLE_SCREEN_WIDGET_LISTENER(name, struct trace_state, name##_update_cb, name##_get_state)
+
+TRACE_WIDGET_LISTENER(trace_wpm, TRACE_WPM)
+TRACE_WIDGET_LISTENER(trace_layer, TRACE_LAYER)
+TRACE_WIDGET_LISTENER(trace_mods, TRACE_MODS)
+
+static int (*const listener_cbs[])(const zmk_event_t *eh) = {trace_wpm_cb, trace_layer_cb, trace_mods_cb};
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(uint32_t range)
+{
+    rng_state = rng_state * 1103515245 + 12345;
+    return (rng_state >> 16) % range;
+}
+
+static void add_event(int64_t time, enum trace_widget widget, uint8_t value)
+{
+    if (event_count < TRACE_MAX_EVENTS)
+    {
+        events[event_count++] = (struct trace_event){.time = time, .widget = widget, .value = value};
+    }
+}
+
+static int compare_events(const void *a, const void *b)
+{
+    const struct trace_event *ea = a;
+    const struct trace_event *eb = b;
+
+    return (ea->time > eb->time) - (ea->time < eb->time);
+}
+
+// Key presses 30 to 150 ms apart with every fourth key rolled in 5 to 25 ms after the previous one, a shift around every seventh key, a layer tap every 30 keys
+// and a layer roll (A -> B -> A within a few ms) every 90 keys. The rate shown by the WPM widget
+// is recalculated on every key press like the dongle side WPM engine does.
+static void generate_trace(void)
+{
+    int64_t presses[TRACE_DURATION_MS / 5];
+    int press_count = 0;
+    int window_start = 0;
+
+    for (int64_t t = 100; t < TRACE_DURATION_MS; t += rng(4) == 0 ? 5 + rng(21) : 30 + rng(121))
+    {
+        presses[press_count++] = t;
+        while (presses[window_start] <= t - TRACE_WPM_WINDOW_MS)
+        {
+            window_start++;
+        }
+
+        int keys = press_count - window_start;
+        add_event(t, TRACE_WPM, MIN(keys * 60000 / TRACE_WPM_WINDOW_MS / 5, 255));
+
+        if (rng(7) == 0)
+        {
+            add_event(t - 10, TRACE_MODS, 0x02);
+            add_event(t + 50, TRACE_MODS, 0x00);
+        }
+        if (press_count % 30 == 0)
+        {
+            add_event(t, TRACE_LAYER, 1);
+            add_event(t + 150, TRACE_LAYER, 0);
+        }
+        if (press_count % 90 == 45)
+        {
+            add_event(t, TRACE_LAYER, 2);
+            add_event(t + 8, TRACE_LAYER, 0);
+        }
+    }
+
+    qsort(events, event_count, sizeof(events[0]), compare_events);
+}
+
+static void replay(int64_t time, enum trace_widget widget, uint8_t value)
+{
+    static const zmk_event_t event;
+
+    host_kernel_run_until(time);
+    event_counts[widget]++;
+    if (trace_values[widget] != value)
+    {
+        changes[widget]++;
+    }
+    trace_values[widget] = value;
+    listener_cbs[widget](&event);
+}
+
+static void reset_counts(void)
+{
+    memset(event_counts, 0, sizeof(event_counts));
+    memset(changes, 0, sizeof(changes));
+    memset(renders, 0, sizeof(renders));
+}
+
+// A burst of changes inside one frame slot costs one render of the newest state
+static int check_burst(void)
+{
+    int64_t start = k_uptime_get() + 1000;
+
+    host_kernel_run_until(start);
+    reset_counts();
+    for (int i = 0; i < 10; i++)
+    {
+        replay(start + i / 2, TRACE_LAYER, i + 1);
+    }
+    host_kernel_run_until(start + 1000);
+
+    if (renders[TRACE_LAYER] != 1 || rendered[TRACE_LAYER] != 10)
+    {
+        fprintf(stderr, "burst of 10 events: %u renders, showing %u (expected 1 render of 10)\n",
+                renders[TRACE_LAYER], rendered[TRACE_LAYER]);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    trace_wpm_init();
+    trace_layer_init();
+    trace_mods_init();
+
+    generate_trace();
+    reset_counts();
+    for (int i = 0; i < event_count; i++)
+    {
+        replay(events[i].time, events[i].widget, events[i].value);
+    }
+    host_kernel_run_until(TRACE_DURATION_MS + 1000);
+
+    printf("Replayed %d events over %d s, frame slot %d ms\n", event_count, TRACE_DURATION_MS / 1000,
+           CONFIG_DONGLE_SCREEN_RENDER_COALESCE_MS);
+    // Events is what one render per event costs, changes what is left after dropping unchanged states
+    printf("%-8s %8s %10s %10s\n", "widget", "events", "changes", "renders");
+
+    unsigned int total_events = 0;
+    unsigned int total_renders = 0;
+    int failed = 0;
+
+    for (int i = 0; i < TRACE_WIDGET_COUNT; i++)
+    {
+        printf("%-8s %8u %10u %10u\n", trace_widget_names[i], event_counts[i], changes[i], renders[i]);
+        total_events += event_counts[i];
+        total_renders += renders[i];
+
+        // Latest wins: whatever got coalesced, the last state is the one on screen
+        if (rendered[i] != trace_values[i])
+        {
+            fprintf(stderr, "%s shows %u instead of %u\n", trace_widget_names[i], rendered[i], trace_values[i]);
+            failed = 1;
+        }
+    }
+    printf("%-8s %8u %10s %10u\n", "total", total_events, "", total_renders);
+
+    if (total_renders > total_events)
+    {
+        failed = 1;
+    }
+
+    return failed | check_burst();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Round-trips images encoded by scripts/rle_image.py through rle_image_decode_row(), for every
+// window of every row, and times decoding whole rows.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "rle_image.h"
+#include "rle_image_vectors.h"
+
+#define BENCH_ROWS 200000
+#define MAX_ROW_BYTES 1024
+
+// Keeps the compiler from dropping the timed loops
+static volatile uint8_t sink;
+
+static const uint8_t *encoded_row(const struct rle_vector *vector, uint16_t y)
+{
+    return &vector->encoded[sys_get_le32(&vector->encoded[y * sizeof(uint32_t)])];
+}
+
+// Every x and len of every row, so windows start and end inside runs, literals and at packet edges
+static int check_vector(const struct rle_vector *vector)
+{
+    uint8_t out[MAX_ROW_BYTES + 1];
+    size_t row_size = vector->width * vector->px_size;
+
+    for (uint16_t y = 0; y < vector->height; y++)
+    {
+        const uint8_t *raw = &vector->raw[y * row_size];
+
+        for (lv_coord_t x = 0; x < vector->width; x++)
+        {
+            for (lv_coord_t len = 1; x + len <= vector->width; len++)
+            {
+                size_t size = len * vector->px_size;
+
+                // The decoder must not write past the requested pixels
+                memset(out, 0xA5, size + 1);
+                rle_image_decode_row(encoded_row(vector, y), vector->px_size, x, len, out);
+
+                if (memcmp(out, &raw[x * vector->px_size], size) != 0 || out[size] != 0xA5)
+                {
+                    fprintf(stderr, "%s: row %u, x %d, len %d decoded wrong\n", vector->name, y, x, len);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Whole rows, the way LVGL reads an image that is drawn completely
+static void bench_vector(const struct rle_vector *vector)
+{
+    static uint8_t out[MAX_ROW_BYTES];
+    size_t row_size = vector->width * vector->px_size;
+    size_t raw_size = row_size * vector->height;
+
+    double start = now_ns();
+    for (int i = 0; i < BENCH_ROWS; i++)
+    {
+        rle_image_decode_row(encoded_row(vector, i % vector->height), vector->px_size, 0, vector->width, out);
+        sink = out[i % row_size];
+    }
+    double decode_ns = (now_ns() - start) / BENCH_ROWS;
+
+    start = now_ns();
+    for (int i = 0; i < BENCH_ROWS; i++)
+    {
+        memcpy(out, &vector->raw[(i % vector->height) * row_size], row_size);
+        sink = out[i % row_size];
+    }
+    double copy_ns = (now_ns() - start) / BENCH_ROWS;
+
+    printf("%-8s %4ux%-4u %8zu %8zu %6.1f%% %9.1f %9.1f %8.1f\n", vector->name, vector->width, vector->height,
+           raw_size, vector->encoded_size, 100.0 * vector->encoded_size / raw_size, decode_ns, copy_ns,
+           row_size / decode_ns * 1000);
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    for (size_t i = 0; i < rle_vector_count; i++)
+    {
+        failed |= check_vector(&rle_vectors[i]);
+    }
+    if (failed)
+    {
+        return failed;
+    }
+
+    printf("%-8s %9s %8s %8s %7s %9s %9s %8s\n", "image", "size", "raw", "encoded", "ratio", "ns/row",
+           "copy ns", "MB/s");
+    for (size_t i = 0; i < rle_vector_count; i++)
+    {
+        bench_vector(&rle_vectors[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+// An image as written by scripts/rle_image.py: the row offset table followed by the rows
+struct rle_vector
+{
+    const char *name;
+    uint16_t width, height;
+    uint8_t px_size;
+    const uint8_t *encoded;
+    size_t encoded_size;
+    const uint8_t *raw; // width x height pixels of px_size bytes
+};
+
+// Written by gen_rle_vectors.py
+extern const struct rle_vector rle_vectors[];
+extern const size_t rle_vector_count;
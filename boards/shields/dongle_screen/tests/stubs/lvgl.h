@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Only the LVGL types and functions the host built sources refer to, nothing here draws.
+// Image types follow LVGL 8.3 with 16 bit colors, the decoder registration does nothing.
+// Objects only keep their coordinates, flags and event callbacks, fonts their callbacks and metrics.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 0
+#define LV_ATTRIBUTE_LARGE_CONST
+
+typedef int16_t lv_coord_t;
+typedef struct _lv_disp_t lv_disp_t;
+
+typedef union
+{
+    uint16_t full;
+} lv_color_t;
+
+typedef uint8_t lv_opa_t;
+#define LV_OPA_TRANSP 0
+#define LV_OPA_COVER 255
+
+static inline lv_color_t lv_color_black(void) { return (lv_color_t){.full = 0x0000}; }
+static inline lv_color_t lv_color_white(void) { return (lv_color_t){.full = 0xFFFF}; }
+
+// lv_color_mix() of LVGL 8.3 for 16 bit colors without LV_COLOR_16_SWAP
+static inline lv_color_t lv_color_mix(lv_color_t c1, lv_color_t c2, uint8_t mix)
+{
+    uint32_t m = ((uint32_t)mix + 4) >> 3;
+    uint32_t bg = ((uint32_t)c2.full | ((uint32_t)c2.full << 16)) & 0x7E0F81F;
+    uint32_t fg = ((uint32_t)c1.full | ((uint32_t)c1.full << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg - bg) * m) >> 5) + bg) & 0x7E0F81F;
+
+    return (lv_color_t){.full = (uint16_t)((result >> 16) | result)};
+}
+
+typedef struct
+{
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;
+    lv_coord_t y2;
+} lv_area_t;
+
+static inline lv_coord_t lv_area_get_width(const lv_area_t *area) { return area->x2 - area->x1 + 1; }
+static inline lv_coord_t lv_area_get_height(const lv_area_t *area) { return area->y2 - area->y1 + 1; }
+
+typedef enum
+{
+    LV_EVENT_DRAW_MAIN,
+    LV_EVENT_DELETE,
+} lv_event_code_t;
+
+typedef struct _lv_obj_t lv_obj_t;
+
+typedef struct
+{
+    lv_obj_t *target;
+    lv_event_code_t code;
+    void *user_data;
+} lv_event_t;
+
+typedef void (*lv_event_cb_t)(lv_event_t *e);
+
+#define LV_OBJ_FLAG_HIDDEN (1 << 0)
+#define HOST_LV_OBJ_EVENTS 4
+
+struct _lv_obj_t
+{
+    lv_area_t coords;
+    uint32_t flags;
+    struct
+    {
+        lv_event_cb_t cb;
+        lv_event_code_t filter;
+        void *user_data;
+    } events[HOST_LV_OBJ_EVENTS];
+};
+
+static inline bool lv_obj_has_flag(const lv_obj_t *obj, uint32_t flag) { return (obj->flags & flag) == flag; }
+static inline void lv_obj_get_coords(const lv_obj_t *obj, lv_area_t *coords) { *coords = obj->coords; }
+static inline void *lv_event_get_user_data(lv_event_t *e) { return e->user_data; }
+
+static inline void lv_obj_add_event_cb(lv_obj_t *obj, lv_event_cb_t cb, lv_event_code_t filter, void *user_data)
+{
+    for (int i = 0; i < HOST_LV_OBJ_EVENTS; i++)
+    {
+        if (obj->events[i].cb == NULL)
+        {
+            obj->events[i].cb = cb;
+            obj->events[i].filter = filter;
+            obj->events[i].user_data = user_data;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Call the callbacks of an object registered for an event, like LVGL does when it sends it
+ */
+static inline void host_lv_event_send(lv_obj_t *obj, lv_event_code_t code)
+{
+    for (int i = 0; i < HOST_LV_OBJ_EVENTS; i++)
+    {
+        if (obj->events[i].cb != NULL && obj->events[i].filter == code)
+        {
+            lv_event_t e = {.target = obj, .code = code, .user_data = obj->events[i].user_data};
+            obj->events[i].cb(&e);
+        }
+    }
+}
+
+typedef struct _lv_font_t lv_font_t;
+
+typedef struct
+{
+    const lv_font_t *resolved_font;
+    uint16_t adv_w;
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint8_t bpp;
+} lv_font_glyph_dsc_t;
+
+struct _lv_font_t
+{
+    bool (*get_glyph_dsc)(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next);
+    const uint8_t *(*get_glyph_bitmap)(const lv_font_t *font, uint32_t letter);
+    lv_coord_t line_height;
+    lv_coord_t base_line;
+    const void *dsc;
+};
+
+static inline bool lv_font_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter,
+                                         uint32_t letter_next)
+{
+    dsc->resolved_font = NULL;
+    if (!font->get_glyph_dsc(font, dsc, letter, letter_next))
+    {
+        return false;
+    }
+    dsc->resolved_font = font;
+    return true;
+}
+
+static inline const uint8_t *lv_font_get_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    return font->get_glyph_bitmap(font, letter);
+}
+
+static inline lv_coord_t lv_font_get_line_height(const lv_font_t *font) { return font->line_height; }
+
+typedef uint8_t lv_res_t;
+#define LV_RES_INV 0
+#define LV_RES_OK 1
+
+enum
+{
+    LV_IMG_CF_UNKNOWN = 0,
+    LV_IMG_CF_RAW,
+    LV_IMG_CF_RAW_ALPHA,
+    LV_IMG_CF_RAW_CHROMA_KEYED,
+    LV_IMG_CF_TRUE_COLOR,
+    LV_IMG_CF_TRUE_COLOR_ALPHA,
+    LV_IMG_CF_USER_ENCODED_0 = 0x18,
+    LV_IMG_CF_USER_ENCODED_1,
+};
+
+#define LV_IMG_PX_SIZE_ALPHA_BYTE 3
+
+typedef struct
+{
+    uint32_t cf : 5;
+    uint32_t always_zero : 3;
+    uint32_t reserved : 2;
+    uint32_t w : 11;
+    uint32_t h : 11;
+} lv_img_header_t;
+
+typedef struct
+{
+    lv_img_header_t header;
+    uint32_t data_size;
+    const uint8_t *data;
+} lv_img_dsc_t;
+
+enum
+{
+    LV_IMG_SRC_VARIABLE,
+    LV_IMG_SRC_FILE,
+    LV_IMG_SRC_SYMBOL,
+    LV_IMG_SRC_UNKNOWN,
+};
+
+static inline uint8_t lv_img_src_get_type(const void *src)
+{
+    return src != NULL ? LV_IMG_SRC_VARIABLE : LV_IMG_SRC_UNKNOWN;
+}
+
+typedef struct _lv_img_decoder_t lv_img_decoder_t;
+
+typedef struct
+{
+    lv_img_decoder_t *decoder;
+    const void *src;
+    const uint8_t *img_data;
+} lv_img_decoder_dsc_t;
+
+typedef lv_res_t (*lv_img_decoder_info_f_t)(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header);
+typedef lv_res_t (*lv_img_decoder_open_f_t)(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc);
+typedef lv_res_t (*lv_img_decoder_read_line_f_t)(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc,
+                                                 lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf);
+
+static inline lv_img_decoder_t *lv_img_decoder_create(void) { return NULL; }
+static inline void lv_img_decoder_set_info_cb(lv_img_decoder_t *decoder, lv_img_decoder_info_f_t cb) {}
+static inline void lv_img_decoder_set_open_cb(lv_img_decoder_t *decoder, lv_img_decoder_open_f_t cb) {}
+static inline void lv_img_decoder_set_read_line_cb(lv_img_decoder_t *decoder, lv_img_decoder_read_line_f_t cb) {}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+
+struct display_buffer_descriptor
+{
+    uint32_t buf_size;
+    uint16_t width;
+    uint16_t height;
+    uint16_t pitch;
+};
+
+// Implemented by the test, which plays the panel
+int display_write(const struct device *dev, const uint16_t x, const uint16_t y,
+                  const struct display_buffer_descriptor *desc, const void *buf);
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Just enough of the Zephyr kernel API to build the dongle screen sources on the host. Time is
+// simulated: delayed work only runs from host_kernel_run_until(), see host_kernel.c.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// IS_ENABLED() works like Zephyr's: 1 for macros defined as 1, 0 for everything else
+#define IS_ENABLED(config) HOST_IS_ENABLED1(config)
+#define HOST_IS_ENABLED1(config) HOST_IS_ENABLED2(HOST_ENABLED_##config)
+#define HOST_ENABLED_1 0,
+#define HOST_IS_ENABLED2(one_or_two_args) HOST_IS_ENABLED3(one_or_two_args 1, 0)
+#define HOST_IS_ENABLED3(ignore, value, ...) value
+
+#define ARG_UNUSED(x) (void)(x)
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define CLAMP(val, low, high) (((val) <= (low)) ? (low) : MIN(val, high))
+#define BIT(n) (1UL << (n))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define BUILD_ASSERT(cond, msg) _Static_assert(cond, msg)
+#define __packed __attribute__((__packed__))
+
+typedef struct host_snode
+{
+    struct host_snode *next;
+} sys_snode_t;
+
+typedef struct
+{
+    sys_snode_t *head;
+    sys_snode_t *tail;
+} sys_slist_t;
+
+#define SYS_SLIST_STATIC_INIT(list) {NULL, NULL}
+
+static inline void sys_slist_append(sys_slist_t *list, sys_snode_t *node)
+{
+    node->next = NULL;
+    if (list->tail == NULL)
+    {
+        list->head = node;
+    }
+    else
+    {
+        list->tail->next = node;
+    }
+    list->tail = node;
+}
+
+static inline bool sys_slist_find_and_remove(sys_slist_t *list, sys_snode_t *node)
+{
+    sys_snode_t *prev = NULL;
+
+    for (sys_snode_t *it = list->head; it != NULL; prev = it, it = it->next)
+    {
+        if (it != node)
+        {
+            continue;
+        }
+        if (prev == NULL)
+        {
+            list->head = it->next;
+        }
+        else
+        {
+            prev->next = it->next;
+        }
+        if (list->tail == it)
+        {
+            list->tail = prev;
+        }
+        return true;
+    }
+    return false;
+}
+
+#define HOST_SLIST_CONTAINER(node, container, field)                                               \
+    ((node) != NULL ? CONTAINER_OF(node, __typeof__(*(container)), field) : NULL)
+#define SYS_SLIST_FOR_EACH_CONTAINER(list, container, field)                                       \
+    for (container = HOST_SLIST_CONTAINER((list)->head, container, field); container != NULL;     \
+         container = HOST_SLIST_CONTAINER((container)->field.next, container, field))
+
+// Single threaded on the host, the atomics only have to behave like the real ones
+typedef long atomic_t;
+typedef long atomic_val_t;
+#define ATOMIC_INIT(i) (i)
+
+static inline bool atomic_cas(atomic_t *target, atomic_val_t old_value, atomic_val_t new_value)
+{
+    if (*target != old_value)
+    {
+        return false;
+    }
+    *target = new_value;
+    return true;
+}
+
+static inline atomic_val_t atomic_get(const atomic_t *target) { return *target; }
+
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value)
+{
+    atomic_val_t old = *target;
+    *target = value;
+    return old;
+}
+
+typedef struct
+{
+    int64_t ms;
+} k_timeout_t;
+
+#define K_MSEC(ms) ((k_timeout_t){(ms)})
+#define K_NO_WAIT K_MSEC(0)
+#define K_FOREVER K_MSEC(-1)
+
+struct k_mutex
+{
+    int unused;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+    ARG_UNUSED(mutex);
+    ARG_UNUSED(timeout);
+    return 0;
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex)
+{
+    ARG_UNUSED(mutex);
+    return 0;
+}
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work
+{
+    k_work_handler_t handler;
+};
+
+/**
+ * @brief Submitted work runs right away, there is no thread to run it later
+ */
+static inline void k_work_init(struct k_work *work, k_work_handler_t handler) { work->handler = handler; }
+static inline bool k_work_cancel(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    return false;
+}
+
+struct k_work_delayable
+{
+    struct k_work work;
+    bool scheduled;
+    int64_t due_ms;
+};
+
+struct k_work_q
+{
+    int unused;
+};
+
+#define K_WORK_DELAYABLE_DEFINE(name, handler_fn) struct k_work_delayable name = {.work = {.handler = handler_fn}}
+
+/**
+ * @brief Schedule delayed work on the simulated clock, a no-op if it is already scheduled
+ */
+int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork, k_timeout_t delay);
+
+static inline int k_work_submit_to_queue(struct k_work_q *queue, struct k_work *work)
+{
+    ARG_UNUSED(queue);
+    work->handler(work);
+    return 1;
+}
+
+int64_t k_uptime_get(void);
+uint32_t k_cycle_get_32(void);
+
+/**
+ * @brief Advance the simulated clock to ms, running all work that gets due on the way in order
+ */
+void host_kernel_run_until(int64_t ms);
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+struct k_work_q *zmk_display_work_q(void);
+bool zmk_display_is_initialized(void);
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Events are delivered by calling the listener callbacks directly, nothing is registered
+typedef struct
+{
+    int unused;
+} zmk_event_t;
+
+#define ZMK_EV_EVENT_BUBBLE 0
+#define ZMK_LISTENER(listener, callback)
+#define ZMK_SUBSCRIPTION(listener, event)
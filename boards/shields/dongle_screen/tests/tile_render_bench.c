@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Updates a three digit display along a WPM-like trace with both renderers of the digit cells and
+// compares what ends up on the panel, the bytes written to it and the time per update. The tile path
+// is the real tile_renderer.c, the LVGL path models how LVGL 8.3's software renderer refreshes an
+// invalidated cell: fill the screen background into the draw buffer, blend the letter on top with
+// a mask like lv_draw_letter(), then flush the area. LVGL's object tree walk and style lookups are
+// left out, so the LVGL times are a lower bound.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/display.h>
+
+#include "tile_renderer.h"
+
+// Cells of the 40px Montserrat digits: the glyphs are generated, only their metrics matter
+#define LINE_HEIGHT 44
+#define BASE_LINE 8
+#define GLYPH_W 22
+#define GLYPH_H 29
+#define GLYPH_ADV 25
+#define SLOTS 3
+#define SLOT_WIDTH GLYPH_ADV
+
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 280
+#define DISPLAY_X 100
+#define DISPLAY_Y 120
+
+// spi-max-frequency of the overlays
+#define SPI_HZ 31000000
+#define TRACE_UPDATES 1000
+#define ITERATIONS 200
+
+// LV_OPA_MIN and LV_OPA_MAX, masks outside are skipped or copied without mixing
+#define OPA_MIN 2
+#define OPA_MAX 253
+
+const struct device host_display = {.name = "host_display"};
+
+// The cells shown and the panel written by one of the renderers
+struct renderer
+{
+    const char *name;
+    bool tile;
+    char cells[SLOTS];
+    uint16_t panel[PANEL_HEIGHT][PANEL_WIDTH];
+    uint32_t panel_bytes;
+};
+
+static struct renderer renderers[] = {
+    {.name = "tile", .tile = true},
+    {.name = "lvgl", .tile = false},
+};
+static struct renderer *current;
+
+static uint8_t glyph_bitmaps[10][(GLYPH_W * GLYPH_H * 4 + 7) / 8];
+
+// Keeps the compiler from dropping the timed loops
+static volatile uint16_t sink;
+
+int display_write(const struct device *dev, const uint16_t x, const uint16_t y,
+                  const struct display_buffer_descriptor *desc, const void *buf)
+{
+    const uint16_t *pixels = buf;
+
+    for (uint16_t row = 0; row < desc->height; row++)
+    {
+        memcpy(&current->panel[y + row][x], &pixels[row * desc->pitch], desc->width * sizeof(uint16_t));
+    }
+    current->panel_bytes += desc->buf_size;
+    return 0;
+}
+
+// A ring with a stroke at a different angle for every digit, with anti-aliased edges
+static void generate_glyphs(void)
+{
+    for (int digit = 0; digit < 10; digit++)
+    {
+        uint32_t bit = 0;
+
+        for (int y = 0; y < GLYPH_H; y++)
+        {
+            for (int x = 0; x < GLYPH_W; x++, bit += 4)
+            {
+                float dx = (x - GLYPH_W / 2.0f) / (GLYPH_W / 2.0f);
+                float dy = (y - GLYPH_H / 2.0f) / (GLYPH_H / 2.0f);
+                float ring = 1.0f - abs((int)((dx * dx + dy * dy) * 16) - 11) / 3.0f;
+                float stroke = 1.0f - abs((int)((dx * (digit - 5) + dy * 5) * 4)) / 3.0f;
+                float coverage = MAX(MAX(ring, stroke), 0.0f);
+                uint8_t value = (uint8_t)(MIN(coverage, 1.0f) * 15);
+
+                glyph_bitmaps[digit][bit >> 3] |= value << (4 - (bit & 7));
+            }
+        }
+    }
+}
+
+static bool font_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter,
+                               uint32_t letter_next)
+{
+    if (letter < '0' || letter > '9')
+    {
+        return false;
+    }
+    *dsc = (lv_font_glyph_dsc_t){
+        .adv_w = GLYPH_ADV, .box_w = GLYPH_W, .box_h = GLYPH_H, .ofs_x = 1, .ofs_y = 0, .bpp = 4};
+    return true;
+}
+
+static const uint8_t *font_get_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    return glyph_bitmaps[letter - '0'];
+}
+
+static const lv_font_t font = {
+    .get_glyph_dsc = font_get_glyph_dsc,
+    .get_glyph_bitmap = font_get_glyph_bitmap,
+    .line_height = LINE_HEIGHT,
+    .base_line = BASE_LINE,
+};
+
+static lv_obj_t display_obj = {
+    .coords = {DISPLAY_X, DISPLAY_Y, DISPLAY_X + SLOTS * SLOT_WIDTH - 1, DISPLAY_Y + LINE_HEIGHT - 1},
+};
+static struct tile tile;
+
+static void tile_draw_cell(int cell)
+{
+    tile_draw_letter(&tile, cell * SLOT_WIDTH, SLOT_WIDTH, &font, current->cells[cell], lv_color_white());
+}
+
+static void tile_repaint(struct tile *tile)
+{
+    for (int i = 0; i < SLOTS; i++)
+    {
+        tile_draw_cell(i);
+    }
+}
+
+static const uint8_t opa_a4[] = {0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+
+// Invalidated areas of the cells are never joined, a joined area would not be smaller than both
+static void lvgl_refresh_cell(int cell)
+{
+    static lv_color_t draw_buf[SLOT_WIDTH * LINE_HEIGHT];
+    lv_color_t color = lv_color_white();
+    char letter = current->cells[cell];
+
+    for (int i = 0; i < SLOT_WIDTH * LINE_HEIGHT; i++)
+    {
+        draw_buf[i] = lv_color_black();
+    }
+
+    lv_font_glyph_dsc_t glyph;
+    if (lv_font_get_glyph_dsc(&font, &glyph, letter, 0))
+    {
+        const uint8_t *bitmap = lv_font_get_glyph_bitmap(&font, letter);
+        lv_coord_t left = (SLOT_WIDTH - glyph.adv_w) / 2 + glyph.ofs_x;
+        lv_coord_t top = font.line_height - font.base_line - glyph.box_h - glyph.ofs_y;
+        uint32_t bit = 0;
+        uint8_t mask[GLYPH_W];
+
+        for (lv_coord_t y = 0; y < glyph.box_h; y++)
+        {
+            for (lv_coord_t x = 0; x < glyph.box_w; x++, bit += 4)
+            {
+                mask[x] = opa_a4[(bitmap[bit >> 3] >> (4 - (bit & 7))) & 0xF];
+            }
+
+            lv_color_t *row = &draw_buf[(top + y) * SLOT_WIDTH + left];
+            for (lv_coord_t x = 0; x < glyph.box_w; x++)
+            {
+                if (mask[x] >= OPA_MAX)
+                {
+                    row[x] = color;
+                }
+                else if (mask[x] > OPA_MIN)
+                {
+                    row[x] = lv_color_mix(color, row[x], mask[x]);
+                }
+            }
+        }
+    }
+
+    const struct display_buffer_descriptor desc = {
+        .buf_size = sizeof(draw_buf),
+        .width = SLOT_WIDTH,
+        .height = LINE_HEIGHT,
+        .pitch = SLOT_WIDTH,
+    };
+    display_write(&host_display, DISPLAY_X + cell * SLOT_WIDTH, DISPLAY_Y, &desc, draw_buf);
+}
+
+// Like digit_display_set_text() with left alignment, only changed cells are drawn
+static void set_value(int value)
+{
+    char text[SLOTS + 1];
+
+    snprintf(text, sizeof(text), "%-3d", value);
+    for (int i = 0; i < SLOTS; i++)
+    {
+        if (text[i] != current->cells[i])
+        {
+            current->cells[i] = text[i];
+            if (current->tile)
+            {
+                tile_draw_cell(i);
+            }
+            else
+            {
+                lvgl_refresh_cell(i);
+            }
+        }
+    }
+}
+
+static int trace[TRACE_UPDATES];
+
+// Typing speed drifting between 0 and 150, every entry changes the shown value
+static void generate_trace(void)
+{
+    uint32_t seed = 1;
+    int value = 0;
+
+    for (int i = 0; i < TRACE_UPDATES; i++)
+    {
+        int next;
+        do
+        {
+            seed = seed * 1103515245 + 12345;
+            next = CLAMP(value + (int)((seed >> 16) % 13) - 6, 0, 150);
+        } while (next == value);
+        trace[i] = value = next;
+    }
+}
+
+static void reset(struct renderer *renderer)
+{
+    memset(renderer->panel, 0, sizeof(renderer->panel));
+    memset(renderer->cells, ' ', sizeof(renderer->cells));
+    renderer->panel_bytes = 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Largest difference of any color channel in the digit display area of both panels
+static int max_diff(void)
+{
+    uint16_t (*a)[PANEL_WIDTH] = renderers[0].panel;
+    uint16_t (*b)[PANEL_WIDTH] = renderers[1].panel;
+    int diff = 0;
+
+    for (int y = DISPLAY_Y; y < DISPLAY_Y + LINE_HEIGHT; y++)
+    {
+        for (int x = DISPLAY_X; x < DISPLAY_X + SLOTS * SLOT_WIDTH; x++)
+        {
+            diff = MAX(diff, abs((a[y][x] >> 11) - (b[y][x] >> 11)));
+            diff = MAX(diff, abs(((a[y][x] >> 5) & 0x3F) - ((b[y][x] >> 5) & 0x3F)));
+            diff = MAX(diff, abs((a[y][x] & 0x1F) - (b[y][x] & 0x1F)));
+        }
+    }
+    return diff;
+}
+
+static void bench(struct renderer *renderer, int diff)
+{
+    current = renderer;
+    reset(renderer);
+
+    double start = now_ns();
+    for (int iteration = 0; iteration < ITERATIONS; iteration++)
+    {
+        for (int i = 0; i < TRACE_UPDATES; i++)
+        {
+            set_value(trace[i]);
+        }
+    }
+    double updates = (double)ITERATIONS * TRACE_UPDATES;
+    double ns = (now_ns() - start) / updates;
+    sink = renderer->panel[DISPLAY_Y][DISPLAY_X];
+
+    double bytes = renderer->panel_bytes / updates;
+    printf("%-6s %14.0f %10.0f %14.1f %9d\n", renderer->name, bytes, ns, bytes * 8 * 1e6 / SPI_HZ, diff);
+}
+
+int main(void)
+{
+    generate_glyphs();
+    generate_trace();
+    for (size_t i = 0; i < ARRAY_SIZE(renderers); i++)
+    {
+        reset(&renderers[i]);
+    }
+
+    // LVGL laid out the tile and sent its draw event, from then on updates go to the panel
+    current = &renderers[0];
+    tile_init(&tile, &display_obj, tile_repaint);
+    host_lv_event_send(&display_obj, LV_EVENT_DRAW_MAIN);
+    if (!tile_shown(&tile))
+    {
+        fprintf(stderr, "tile not shown after its draw event\n");
+        return 1;
+    }
+
+    // Both renderers must leave the same pixels on the panel after every update
+    int diff = 0;
+    for (int i = 0; i < TRACE_UPDATES; i++)
+    {
+        for (size_t r = 0; r < ARRAY_SIZE(renderers); r++)
+        {
+            current = &renderers[r];
+            set_value(trace[i]);
+        }
+        diff = MAX(diff, max_diff());
+    }
+    if (diff > 0)
+    {
+        fprintf(stderr, "renderers differ by up to %d after the same updates\n", diff);
+        return 1;
+    }
+
+    printf("%-6s %14s %10s %14s %9s\n", "path", "bytes/update", "ns/update", "SPI us/update", "max diff");
+    for (size_t i = 0; i < ARRAY_SIZE(renderers); i++)
+    {
+        bench(&renderers[i], diff);
+    }
+    printf("tile RAM: %d B scratch buffer, %zu B per digit display (host struct tile)\n",
+           CONFIG_DONGLE_SCREEN_TILE_BUFFER_SIZE, sizeof(struct tile));
+    return 0;
+}
@@ -47,6 +47,8 @@ struct st7789v_config {
 	uint8_t rgb_param[3];
 	uint16_t height;
 	uint16_t width;
+	uint16_t x_offset;
+	uint16_t y_offset;
 };
 
 struct st7789v_data {
@@ -239,42 +241,41 @@ static int st7789v_set_orientation(const struct device *dev,
 	uint16_t x_offset = 0;
 	uint16_t y_offset = 0;
 
-	uint16_t row_offset = 0;
-	uint16_t col_offset = 0;
-
-	// if (config->width < 240) {
-		/* 135x240 display */
-		row_offset = data->y_offset;
-		col_offset = data->x_offset;
-	// } else {
-	// 	/* 240x320 and 240x240 displays */
-	// 	row_offset = (320 - config->height);
-	// 	col_offset = (240 - config->width);
-	// }
+	/*
+	 * The panel shows a window of the 240x320 controller RAM, starting at the offsets from
+	 * the devicetree. Exchanging the axes (MV) makes x address the RAM rows and y the columns.
+	 * Mirroring the columns (MX) or rows (MY) mirrors the window along them, so their offset
+	 * becomes the margin on the other side, whichever of x and y they are addressed by. Always
+	 * derived from the devicetree values, so rotating again never accumulates.
+	 */
+	uint16_t col_offset = config->x_offset;
+	uint16_t row_offset = config->y_offset;
+	uint16_t col_offset_mirrored = ST7789V_RAM_WIDTH - config->width - config->x_offset;
+	uint16_t row_offset_mirrored = ST7789V_RAM_HEIGHT - config->height - config->y_offset;
 
 	switch (orientation) {
 	case DISPLAY_ORIENTATION_NORMAL:
 		tx_data |= ST7789V_MADCTL_MV_NORMAL_MODE;
-		x_offset = data->x_offset;
-		y_offset = data->y_offset;
+		x_offset = col_offset;
+		y_offset = row_offset;
 		break;
 
 	case DISPLAY_ORIENTATION_ROTATED_90:
 		tx_data |= (ST7789V_MADCTL_MY_BOTTOM_TO_TOP | ST7789V_MADCTL_MV_REVERSE_MODE);
-		x_offset = row_offset;
+		x_offset = row_offset_mirrored;
 		y_offset = col_offset;
 		break;
 
 	case DISPLAY_ORIENTATION_ROTATED_180:
 		tx_data |= (ST7789V_MADCTL_MY_BOTTOM_TO_TOP | ST7789V_MADCTL_MX_RIGHT_TO_LEFT);
-		x_offset = col_offset;
-		y_offset = row_offset;
+		x_offset = col_offset_mirrored;
+		y_offset = row_offset_mirrored;
 		break;
 
 	case DISPLAY_ORIENTATION_ROTATED_270:
 		tx_data |= (ST7789V_MADCTL_MX_RIGHT_TO_LEFT | ST7789V_MADCTL_MV_REVERSE_MODE);
-		x_offset = data->y_offset;
-		y_offset = data->x_offset;
+		x_offset = row_offset;
+		y_offset = col_offset_mirrored;
 		break;
 
 	default:
@@ -462,6 +463,8 @@ static const struct display_driver_api st7789v_api = {
 		.rgb_param = DT_INST_PROP(inst, rgb_param),                                        \
 		.width = DT_INST_PROP(inst, width),                                                \
 		.height = DT_INST_PROP(inst, height),                                              \
+		.x_offset = DT_INST_PROP(inst, x_offset),                                          \
+		.y_offset = DT_INST_PROP(inst, y_offset),                                          \
 	};                                                                                         \
                                                                                                    \
 	static struct st7789v_data st7789v_data_##inst = {                                         \
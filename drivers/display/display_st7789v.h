@@ -8,6 +8,10 @@
 
 #include <zephyr/kernel.h>
 
+/* Size of the controller RAM, panels show a window of it */
+#define ST7789V_RAM_WIDTH			240
+#define ST7789V_RAM_HEIGHT			320
+
 #define ST7789V_CMD_NOP				0x00
 #define ST7789V_CMD_SW_RESET			0x01
 